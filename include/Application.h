@@ -1,7 +1,9 @@
 #pragma once
+#include "DiskCache.h"
 #include "History.h"
 #include "Overlay.h"
 #include "Render.h"
+#include "ResultCache.h"
 #include "Save.h"
 #include "TextEntry.h"
 #include <chrono>
@@ -24,12 +26,30 @@ private:
 	bool _show_help;
 	int_t _titlebar_height;
 	
-	sf::Image _image;
+	FrameBuffer _frames;
 	sf::Sprite _sprite;
 	sf::Texture _texture;
 
+	// A zoom's preview, for the next render
+	preview_ptr _preview;
+	bool _render_finished;
+
+	// Recordings iterate progressively in long double, so neither the caches
+	// nor previews take their escapes for those of a coarse-to-fine render
+	bool _render_recorded;
+
+	// Finished renders by view, in memory and on disk, and the state of the
+	// last one started
+	ResultCache _results;
+	DiskCache _disk;
+	State _rendered_state;
+
+	control_ptr _control;
 	std::thread _render_thread;
 	std::thread _clock_thread;
+
+	control_ptr NewControl();
+	void NewPreview(const Geometry2D& from, bool resume = false);
 public:
 	static const int_t MSG_DURATION_SEC;
 	static const int_t POLLING_DELAY_MSEC;
@@ -42,6 +62,10 @@ public:
 	const canvas_t& canvas() const;
 	const Geometry2D& scales() const;
 	const sf::Image& image() const;
+
+	// Memory the finished renders kept for revisiting may take
+	size_t cache_budget() const;
+	Application& cache_budget(size_t bytes);
 	
 	Application(font_t& font, int_t width_pixels, int_t height_pixels, const std::string& title);
 	Application(const Application&) = delete;
@@ -56,6 +80,7 @@ public:
 	void RestartRender();
 	void ChangeOverlay(std::function<void()>);
 	void ChangeOverlayAndHistory(std::function<void()>);
+	void ChangeColorScheme(std::function<void()>);
 	bool GoToPreviousState();
 	bool GoToNextState();
 	void RebuildGeometry();
@@ -74,10 +99,12 @@ public:
 	bool Save(sf::Sprite& someSprite);
 	bool Save();
 	void GoTo(const std::string& str);
+	void ChangeMaximum(int_t max);
 	bool EnterNewMaximum(int_t& max);
 	bool EnterNewCoordinates(pair_t& coords);
 
 	bool ToggleOverlay();
+	bool IsPaused() const;
 	bool TogglePauseRender();
 	bool ToggleHelpMessage(const char* msg);
 	bool IsOpen() const;
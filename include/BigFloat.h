@@ -0,0 +1,99 @@
+#pragma once
+#include "DoubleDouble.h"
+#include "types.h"
+#include <ostream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+const size_t LIMB_BITS = 32;
+
+// Two limbs hold any flt_t exactly
+const size_t MIN_LIMBS = 2;
+
+// Coordinates stay below 2^COORD_BITS in magnitude
+const int_t COORD_BITS = 3LL;
+
+// Bits kept below the pixel spacing, so a zoom by up to 2^GUARD_BITS still
+// lands on exact coordinates
+const int_t GUARD_BITS = 64LL;
+
+// A binary floating-point number with as many 32-bit limbs of significand
+// as it is given, and an exponent that does not run out:
+//
+//    x = (-1)^negative 0.m_0 m_1 ... m_(n-1) 2^exponent,  m_0 >= 2^31
+//
+// Sums and products keep the limbs of their longer operand, so the cost
+// of every operation follows the zoom depth the coordinates were sized for
+// (LimbsForSpacing). Products are truncated to those limbs and one guard
+// limb, skipping the lower half of the schoolbook columns
+class BigFloat {
+private:
+	bool _negative;
+	int_t _exponent;
+	std::vector<uint32_t> _mantissa;
+
+	BigFloat& normalize();
+
+	template <typename T>
+	T to_float() const;
+
+	static int CompareMagnitudes(const BigFloat& a, const BigFloat& b);
+	static BigFloat AddMagnitudes(const BigFloat& a, const BigFloat& b);
+	static BigFloat SubtractMagnitudes(const BigFloat& a, const BigFloat& b);
+public:
+	BigFloat();
+	BigFloat(int value);
+	BigFloat(double value);
+	BigFloat(long double value);
+	BigFloat(long double value, size_t limbs);
+
+	explicit operator float() const;
+	explicit operator double() const;
+	explicit operator long double() const;
+	explicit operator dd_t() const;
+
+	size_t limbs() const;
+	BigFloat& limbs(size_t count);
+
+	bool negative() const;
+	bool zero() const;
+
+	// Sign, exponent and limbs in hex: equal text, equal numbers
+	std::string hex() const;
+
+	// Limbs that resolve coordinates spacing apart
+	static size_t LimbsForSpacing(flt_t spacing);
+
+	BigFloat& operator+=(const BigFloat& other);
+	BigFloat& operator-=(const BigFloat& other);
+	BigFloat& operator*=(const BigFloat& other);
+
+	friend const BigFloat operator-(const BigFloat& a);
+	friend const BigFloat operator+(const BigFloat& a, const BigFloat& b);
+	friend const BigFloat operator*(const BigFloat& a, const BigFloat& b);
+	friend bool operator<(const BigFloat& a, const BigFloat& b);
+	friend bool operator==(const BigFloat& a, const BigFloat& b);
+};
+
+const BigFloat operator-(const BigFloat& a);
+const BigFloat operator+(const BigFloat& a, const BigFloat& b);
+const BigFloat operator*(const BigFloat& a, const BigFloat& b);
+
+inline const BigFloat operator-(const BigFloat& a, const BigFloat& b) { return a + (-b); }
+
+inline BigFloat& BigFloat::operator+=(const BigFloat& other) { return *this = *this + other; }
+inline BigFloat& BigFloat::operator-=(const BigFloat& other) { return *this = *this - other; }
+inline BigFloat& BigFloat::operator*=(const BigFloat& other) { return *this = *this * other; }
+
+bool operator<(const BigFloat& a, const BigFloat& b);
+bool operator==(const BigFloat& a, const BigFloat& b);
+
+inline bool operator>(const BigFloat& a, const BigFloat& b) { return b < a; }
+inline bool operator<=(const BigFloat& a, const BigFloat& b) { return !(b < a); }
+inline bool operator>=(const BigFloat& a, const BigFloat& b) { return !(a < b); }
+inline bool operator!=(const BigFloat& a, const BigFloat& b) { return !(a == b); }
+
+inline BigFloat abs(const BigFloat& a) { return a.negative() ? -a : a; }
+
+std::ostream& operator<<(std::ostream& out, const BigFloat& a);
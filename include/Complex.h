@@ -47,11 +47,45 @@ public:
 
 typedef Complex<flt_t> pair_t;
 
+template <typename T>
+T sq_sum(const Complex<T>& z) {
+	return z.re() * z.re() + z.im() * z.im();
+}
+
 template <typename T>
 Complex<T> conj(const Complex<T>& complex) {
 	return Complex<T>(complex.re(), -complex.im());
 }
 
+/*
+	(a + bi)^2 = (a^2 - b^2) + 2abi
+*/
+template <typename T>
+Complex<T> sq(const Complex<T>& z) {
+	return Complex<T>(
+		z.re() * z.re() - z.im() * z.im(),
+		(T)2 * z.re() * z.im()
+	);
+}
+
+/*
+	z^N by squaring, unrolled at compile time
+
+		z^(2k) = (z^k)^2
+		z^(2k + 1) = z (z^k)^2
+*/
+template <int_t N, typename T>
+Complex<T> ipow(const Complex<T>& z) {
+	static_assert(N > 0, "ipow requires a positive power");
+
+	if constexpr (N == 1)
+		return z;
+	else if constexpr (N % 2 == 0)
+		return sq(ipow<N / 2>(z));
+	else
+		return z * sq(ipow<N / 2>(z));
+}
+
 pair_t cos(const pair_t& z);
 pair_t sin(const pair_t& z);
 pair_t tan(const pair_t& z);
@@ -74,7 +108,6 @@ pair_t pow(const pair_t& z, int_t a);
 pair_t pow(flt_t a, const pair_t& z);
 pair_t pow(const pair_t& z, const pair_t& w);
 pair_t fpow(const pair_t& z, flt_t w);
-flt_t sq_sum(const pair_t& z);
 pair_t sqrt(const pair_t& z);
 
 template <typename T>
@@ -0,0 +1,76 @@
+#pragma once
+#include "State.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Cells along each side of a tile: 1 MB of escapes a tile
+const int_t TILE_CELLS = 256LL;
+
+// Tiles the cache keeps at most, about 1 GB
+const size_t DEFAULT_CACHE_TILES = 1024;
+
+// Levels past this are deeper than long double coordinates tell cells apart
+// by much, and are not kept
+const int_t MAX_TILE_LEVEL = 52LL;
+
+// Under the user's cache directory, so it does not follow the working
+// directory
+std::string DefaultCacheDirectory();
+
+// Escapes of finished renders kept on disk between sessions, as a quadtree
+// of tiles over the complex plane. The cells of level L are squares 2^-L
+// wide, L chosen so a cell is no wider than a pixel; a view stores each
+// pixel's escape in the cell its coordinates fall in, and reads it back
+// from there. The same view thus reads back exactly, and views panned or
+// zoomed to the same spacing take the cells they cover, each from a point
+// less than a cell away. Tiles of TILE_CELLS squared cells are files named
+// by level and index, under a directory named by the function's fields, and
+// each starts with the whole key, checked on load. Views are written on a
+// thread of their own, and the least recently written tiles are dropped
+// past the budget
+class DiskCache {
+private:
+	struct Job {
+		std::string key;
+		int_t level;
+		Geometry2D scales;
+		std::vector<escape_t> values;
+	};
+
+	std::string _directory;
+	size_t _tiles;
+
+	std::mutex _mutex;
+	std::condition_variable _queued;
+	std::condition_variable _written;
+	std::deque<Job> _jobs;
+	bool _writing;
+	bool _stopping;
+	std::thread _writer;
+
+	std::string path(const std::string& key, int_t level, int_t tile_x, int_t tile_y) const;
+	void Work();
+	void Write(const Job& job);
+	void Trim();
+public:
+	DiskCache(const std::string& directory = DefaultCacheDirectory(), size_t tiles = DEFAULT_CACHE_TILES);
+	DiskCache(const DiskCache&) = delete;
+	DiskCache& operator=(const DiskCache&) = delete;
+
+	// Writes what was stored before returning
+	~DiskCache();
+
+	// The pixels of the state's view whose cells are on disk, their escapes
+	// in values and flags in known
+	size_t load(const State& state, std::vector<escape_t>& values, std::vector<bool>& known) const;
+
+	// Queued for the writer, which merges it into the tiles it covers
+	void store(const State& state, const std::vector<escape_t>& values);
+
+	// Waits for the views stored so far to be written
+	void flush();
+};
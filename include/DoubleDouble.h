@@ -0,0 +1,106 @@
+#pragma once
+#include "types.h"
+#include <math.h>
+
+// Source:
+//    Hida, Li, Bailey, "Library for Double-Double and Quad-Double Arithmetic"
+//    Dekker, "A Floating-Point Technique for Extending the Available Precision"
+//
+// An unevaluated sum hi + lo of two doubles, |lo| <= ulp(hi) / 2, giving
+// about 106 bits of significand using only double arithmetic
+struct dd_t {
+	double hi;
+	double lo;
+
+	dd_t() : hi(0.0), lo(0.0) {}
+	dd_t(int value) : hi(value), lo(0.0) {}
+	dd_t(double value) : hi(value), lo(0.0) {}
+	dd_t(long double value) :
+		hi(static_cast<double>(value)),
+		lo(static_cast<double>(value - static_cast<long double>(static_cast<double>(value)))) {}
+	dd_t(double high, double low) : hi(high), lo(low) {}
+
+	explicit operator float() const { return static_cast<float>(hi); }
+	explicit operator double() const { return hi + lo; }
+	explicit operator long double() const { return static_cast<long double>(hi) + lo; }
+
+	dd_t& operator+=(const dd_t& other);
+	dd_t& operator-=(const dd_t& other);
+	dd_t& operator*=(const dd_t& other);
+};
+
+namespace dd
+{
+	/*
+		s + e = a + b exactly, given |a| >= |b|
+	*/
+	inline dd_t quick_two_sum(double a, double b) {
+		double s = a + b;
+		return dd_t(s, b - (s - a));
+	}
+
+	/*
+		s + e = a + b exactly
+	*/
+	inline dd_t two_sum(double a, double b) {
+		double s = a + b;
+		double v = s - a;
+		return dd_t(s, (a - (s - v)) + (b - v));
+	}
+
+	/*
+		a = hi + lo, each half fitting in 26 bits
+	*/
+	inline void split(double a, double& hi, double& lo) {
+		const double SPLITTER = 134217729.0; // 2^27 + 1
+		double t = SPLITTER * a;
+		hi = t - (t - a);
+		lo = a - hi;
+	}
+
+	/*
+		p + e = a * b exactly
+	*/
+	inline dd_t two_prod(double a, double b) {
+		double p = a * b;
+#ifdef FP_FAST_FMA
+		return dd_t(p, fma(a, b, -p));
+#else
+		double a_hi, a_lo, b_hi, b_lo;
+		split(a, a_hi, a_lo);
+		split(b, b_hi, b_lo);
+		return dd_t(p, ((a_hi * b_hi - p) + a_hi * b_lo + a_lo * b_hi) + a_lo * b_lo);
+#endif
+	}
+};
+
+inline const dd_t operator-(const dd_t& a) {
+	return dd_t(-a.hi, -a.lo);
+}
+
+inline const dd_t operator+(const dd_t& a, const dd_t& b) {
+	auto s = dd::two_sum(a.hi, b.hi);
+	auto t = dd::two_sum(a.lo, b.lo);
+	s = dd::quick_two_sum(s.hi, s.lo + t.hi);
+	return dd::quick_two_sum(s.hi, s.lo + t.lo);
+}
+
+inline const dd_t operator-(const dd_t& a, const dd_t& b) {
+	return a + (-b);
+}
+
+inline const dd_t operator*(const dd_t& a, const dd_t& b) {
+	auto p = dd::two_prod(a.hi, b.hi);
+	return dd::quick_two_sum(p.hi, p.lo + (a.hi * b.lo + a.lo * b.hi));
+}
+
+inline dd_t& dd_t::operator+=(const dd_t& other) { return *this = *this + other; }
+inline dd_t& dd_t::operator-=(const dd_t& other) { return *this = *this - other; }
+inline dd_t& dd_t::operator*=(const dd_t& other) { return *this = *this * other; }
+
+inline bool operator<(const dd_t& a, const dd_t& b) { return a.hi < b.hi || (a.hi == b.hi && a.lo < b.lo); }
+inline bool operator>(const dd_t& a, const dd_t& b) { return b < a; }
+inline bool operator<=(const dd_t& a, const dd_t& b) { return !(b < a); }
+inline bool operator>=(const dd_t& a, const dd_t& b) { return !(a < b); }
+inline bool operator==(const dd_t& a, const dd_t& b) { return a.hi == b.hi && a.lo == b.lo; }
+inline bool operator!=(const dd_t& a, const dd_t& b) { return !(a == b); }
@@ -0,0 +1,93 @@
+#pragma once
+#include "Palette.h"
+#include "Tiles.h"
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <stdint.h>
+#include <vector>
+
+// Three images rotate between the render thread, which draws into back()
+// and publish()es it, and the UI thread, which acquire()s the newest
+// published frame as front(). Either hand-off is one atomic exchange of the
+// middle image's index, so neither thread waits, copies a whole image or
+// touches the image the other is using.
+//
+// The image publish() hands back to the renderer is a frame or more behind;
+// back() brings it up to date by copying in only the tiles touched since.
+// The same record of touched tiles lets upload() send the UI's texture only
+// the rectangles that changed.
+//
+// Alongside the images the renderer keeps where every pixel's orbit
+// escaped, the input of the algorithm and color scheme, so a finished
+// render can be recolor()ed under others without iterating again
+class FrameBuffer {
+private:
+	// Set in _middle while it holds a frame the UI has not acquired
+	static const uint8_t FRESH = 4;
+
+	sf::Image _images[3];
+	int_t _versions[3];
+	std::vector<int_t> _tile_versions[3];  // the version each tile last changed in
+	std::atomic<uint8_t> _middle;
+	std::vector<escape_t> _values;  // BOUNDED where an orbit is bounded or not yet done
+	std::vector<stopped_t> _stopped;
+	int_t _stopped_at;
+
+	// Render thread only
+	uint8_t _back;
+	uint8_t _published;
+	bool _stale;
+	int_t _version;
+	std::vector<view_t> _tiles;
+	std::vector<int_t> _touched;
+
+	// UI thread only
+	uint8_t _front;
+	int_t _uploaded;
+	std::vector<sf::Uint8> _staging;
+
+	void reset();
+	void upload(sf::Texture& texture, const view_t& rect);
+public:
+	FrameBuffer();
+	FrameBuffer(const FrameBuffer&) = delete;
+	FrameBuffer& operator=(const FrameBuffer&) = delete;
+
+	// Fills all three images; neither thread may be using the buffer
+	void create(unsigned width, unsigned height, const sf::Color& color);
+	void create(const sf::Image& image, const std::vector<escape_t>& values);
+	void create(unsigned width, unsigned height, const std::vector<escape_t>& values, const Palette& palette);
+
+	void layout(const TileScheduler& tiles);
+	sf::Image& back();
+	void touch(size_t tile);
+	void touch_all();
+	void publish();
+	const sf::Image& published() const;
+
+	// The escape of each pixel back() was last given, row by row; render
+	// workers set distinct pixels
+	const std::vector<escape_t>& values() const;
+	const escape_t& value(int_t x, int_t y) const;
+	void value(int_t x, int_t y, const escape_t& value);
+
+	// Orbits the last finished render stopped at its maximum, stopped_at(),
+	// before they escaped or repeated; none once the buffer is created again
+	const std::vector<stopped_t>& stopped() const;
+	int_t stopped_at() const;
+	void stopped(std::vector<stopped_t> orbits, int_t iteration);
+
+	// Colors every pixel from its escape and publishes the result; no render
+	// may be running
+	void recolor(const Palette& palette);
+
+	// Whether a frame was published since the last acquire; if so it is
+	// now front()
+	bool acquire();
+	const sf::Image& front() const;
+
+	// Acquires the newest frame and updates texture with the tiles changed
+	// since the last frame it was given; false, and nothing uploaded, when
+	// no frame was published since
+	bool upload(sf::Texture& texture);
+};
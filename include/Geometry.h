@@ -1,43 +1,72 @@
 #pragma once
+#include "BigFloat.h"
 #include "Debug.h"
 #include "types.h"
 #include <assert.h>
 #include <memory>
 
-class Scale {
+// Maps pixels to coordinates of type T (flt_t, or BigFloat for coordinates
+// deeper than flt_t resolves). The factor between them is a flt_t in either
+// case: only the coordinates need the precision, not their spacing
+template <typename T>
+class BasicScale {
 private:
 	flt_t _coord_to_pixel;
 
 	int_t _min_pixel;
 	int_t _max_pixel;
 
-	flt_t _min_coord;
-	flt_t _max_coord;
+	T _min_coord;
+	T _max_coord;
 public:
-	Scale(int_t minPixel, int_t maxPixel, flt_t minCoord, flt_t maxCoord);
-	virtual ~Scale();
-
-	static flt_t GetCoordToPixelFactor(int_t minPixel, int_t maxPixel, flt_t minCoord, flt_t maxCoord);
+	BasicScale(int_t minPixel, int_t maxPixel, const T& minCoord, const T& maxCoord);
+	virtual ~BasicScale();
+
+	// The same pixels and spacing, with coordinates rounded to T
+	template <typename U>
+	explicit BasicScale(const BasicScale<U>& other) :
+		_coord_to_pixel(other.coord_to_pixel()),
+		_min_pixel(other.min_pixel()),
+		_max_pixel(other.max_pixel()),
+		_min_coord(T(other.min_coord())),
+		_max_coord(T(other.max_coord())) {}
+
+	static flt_t GetCoordToPixelFactor(int_t minPixel, int_t maxPixel, const T& minCoord, const T& maxCoord);
+
+	int_t to_pixel(const T& coord) const;
+	T to_coord(int_t pixel) const;
+
+	// The offset from min_coord is exact enough in flt_t; only the sum needs
+	// a wider U once pixel spacing nears flt_t's epsilon
+	template <typename U>
+	U to_coord_as(int_t pixel) const {
+		return U(_min_coord) + U((pixel - _min_pixel) / _coord_to_pixel);
+	}
 
-	int_t to_pixel(flt_t coord) const;
-	flt_t to_coord(int_t pixel) const;
+	// Coordinate distance between neighbouring pixels
+	flt_t pixel_size() const;
+	flt_t coord_to_pixel() const;
 
 	int_t min_pixel() const;
 	int_t max_pixel() const;
-	flt_t min_coord() const;
-	flt_t max_coord() const;
+	T min_coord() const;
+	T max_coord() const;
 };
 
-class YScale : public Scale {
+template <typename T>
+class BasicYScale : public BasicScale<T> {
 public:
-	YScale(int_t minPixel, int_t maxPixel, flt_t minCoord, flt_t maxCoord);
-	virtual ~YScale();
+	BasicYScale(int_t minPixel, int_t maxPixel, const T& minCoord, const T& maxCoord);
+	virtual ~BasicYScale();
 
-	int_t to_pixel(flt_t coord) const;
-	flt_t to_coord(int_t pixel) const;
-	flt_t to_coord_uninverted(int_t pixel) const;
+	int_t to_pixel(const T& coord) const;
+	T to_coord(int_t pixel) const;
+	T to_coord_uninverted(int_t pixel) const;
 };
 
+typedef BasicScale<flt_t> Scale;
+typedef BasicYScale<flt_t> YScale;
+
 template <typename T>
 struct Boundaries {
 	T left;
@@ -47,7 +76,7 @@ struct Boundaries {
 };
 
 template <typename T>
-const Boundaries<T>& AssertNewBounds(T left, T right, T top, T bottom) {
+Boundaries<T> AssertNewBounds(T left, T right, T top, T bottom) {
 	bool noZeroLengths = left != right && top != bottom;
 
 #ifdef DEBUG
@@ -65,39 +94,63 @@ const Boundaries<T>& AssertNewBounds(T left, T right, T top, T bottom) {
 
 typedef Boundaries<int_t> view_t;
 typedef Boundaries<flt_t> model_t;
+typedef Boundaries<BigFloat> deep_model_t;
+
+template <typename T, typename U>
+Boundaries<T> BoundariesCast(const Boundaries<U>& bounds) {
+	return Boundaries<T> { T(bounds.left), T(bounds.right), T(bounds.top), T(bounds.bottom) };
+}
 
-class Geometry2D {
+template <typename T>
+class BasicGeometry2D {
 private:
-	Scale _horz;
-	Scale _vert;
+	BasicScale<T> _horz;
+	BasicScale<T> _vert;
 public:
-	Geometry2D(const view_t& view, const model_t& model);
-	Geometry2D(const Geometry2D&) = default;
-	Geometry2D(Geometry2D&&) = default;
-	Geometry2D();
-	virtual ~Geometry2D();
+	BasicGeometry2D(const view_t& view, const Boundaries<T>& model);
+	BasicGeometry2D(const BasicGeometry2D&) = default;
+	BasicGeometry2D(BasicGeometry2D&&) = default;
+	BasicGeometry2D();
+	virtual ~BasicGeometry2D();
 
-	Geometry2D& operator=(const Geometry2D&) = default;
-	Geometry2D& operator=(Geometry2D&&) = default;
+	template <typename U>
+	explicit BasicGeometry2D(const BasicGeometry2D<U>& other) :
+		_horz(other.horz()),
+		_vert(other.vert()) {}
 
-	Scale horz() const;
-	Scale vert() const;
+	BasicGeometry2D& operator=(const BasicGeometry2D&) = default;
+	BasicGeometry2D& operator=(BasicGeometry2D&&) = default;
 
-	void horz(const Scale& other);
-	void vert(const Scale& other);
-	void horz(int_t minPixel, int_t maxPixel, flt_t minCoord, flt_t maxCoord);
-	void vert(int_t minPixel, int_t maxPixel, flt_t minCoord, flt_t maxCoord);
+	BasicScale<T> horz() const;
+	BasicScale<T> vert() const;
 
-	flt_t coord_x(int_t pixel_x) const;
-	flt_t coord_y(int_t pixel_x) const;
-	flt_t coord_y_uninverted(int_t pixel_y) const;
+	void horz(const BasicScale<T>& other);
+	void vert(const BasicScale<T>& other);
+	void horz(int_t minPixel, int_t maxPixel, const T& minCoord, const T& maxCoord);
+	void vert(int_t minPixel, int_t maxPixel, const T& minCoord, const T& maxCoord);
+
+	T coord_x(int_t pixel_x) const;
+	T coord_y(int_t pixel_x) const;
+	T coord_y_uninverted(int_t pixel_y) const;
+
+	template <typename U>
+	U coord_x_as(int_t pixel_x) const { return _horz.template to_coord_as<U>(pixel_x); }
+
+	template <typename U>
+	U coord_y_as(int_t pixel_y) const { return _vert.template to_coord_as<U>(pixel_y); }
 
 	void resize(int_t min_x, int_t max_x, int_t min_y, int_t max_y);
-	void transform(flt_t min_x, flt_t max_x, flt_t min_y, flt_t max_y);
+	void transform(const T& min_x, const T& max_x, const T& min_y, const T& max_y);
 	void resize(const view_t& view);
-	void transform(const model_t& model);
+	void transform(const Boundaries<T>& model);
 };
 
+typedef BasicGeometry2D<flt_t> Geometry2D;
+
+// Geometry of the view at the model's full precision, for the coordinates
+// of zooms and of perturbation's reference orbit
+typedef BasicGeometry2D<BigFloat> DeepGeometry2D;
+
 typedef std::shared_ptr<Geometry2D> geo_ptr;
 
 class Plot2D {
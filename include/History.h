@@ -1,6 +1,6 @@
 #pragma once
 #include <list>
-#include <vcruntime.h>
+#include <cstddef>
 
 template <typename T>
 class History {
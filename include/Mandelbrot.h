@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "Complex.h"
+#include "DoubleDouble.h"
 #include "Geometry.h"
 #include <SFML/Graphics.hpp>
 
@@ -13,6 +14,26 @@ sizeof(arr)/sizeof(arr[0])
 
 typedef flt_t threshold_t;
 
+// An orbit's result apart from its color: the iteration it escaped at and
+// |z|^2 there, or iteration -1 where it stayed bounded
+struct escape_t {
+	int_t iteration;
+	double norm;
+};
+
+const escape_t BOUNDED{ -1LL, 0. };
+
+// An orbit stopped at the maximum before it escaped or repeated. Drawn as
+// BOUNDED, but a higher maximum can go on from where it stopped
+const escape_t STOPPED{ -2LL, 0. };
+
+// Where a pixel's orbit stopped, for a higher maximum to go on from
+struct stopped_t {
+	int_t x;
+	int_t y;
+	pair_t z;
+};
+
 namespace mnd
 {
 	const sf::Color INIT_COLOR(0, 0, 0);
@@ -29,9 +50,12 @@ namespace mnd
 
 	typedef pair_t(*complex_f)(pair_t z, pair_t c, int_t power);
 	typedef sf::Color(*color_code_f)(flt_t);
-	typedef int_t(*algorithm_f)(pair_t& z, const pair_t& c, int_t power, int_t iteration, threshold_t threshold, complex_f f);
+	typedef int_t(*escape_f)(flt_t norm, int_t iteration);
+
+	template <typename T>
+	using orbit_f = escape_t(*)(Complex<T>& z, Complex<T> c, int_t start, int_t max_iterations, threshold_t threshold, T period_tolerance);
 
-	const wchar_t const* const FUNCTION_NAMES[] = {
+	const wchar_t* const FUNCTION_NAMES[] = {
 		  L"z^|z| + c"
 		, L"exp(z) + c"
 		, L"sin(z) + c"
@@ -105,13 +129,142 @@ namespace mnd
 
 	constexpr int_t NUM_FUNCTIONS = ARRAY_SIZE(FUNCTIONS);
 
+	// z^N + c with multiplications only, used in place of FUNCTIONS[POWER_F_INDEX]
+	// for the integer powers in [MIN_POWER_KERNEL, MAX_POWER_KERNEL]
+	template <int_t N>
+	pair_t PowerKernel(pair_t z, pair_t c, int_t /*power*/) {
+		return c + ipow<N>(z);
+	}
+
+	const int_t MIN_POWER_KERNEL = 2LL;
+	const int_t MAX_POWER_KERNEL = 9LL;
+
+	const complex_f POWER_KERNELS[] = {
+		  PowerKernel<2>
+		, PowerKernel<3>
+		, PowerKernel<4>
+		, PowerKernel<5>
+		, PowerKernel<6>
+		, PowerKernel<7>
+		, PowerKernel<8>
+		, PowerKernel<9>
+	};
+
+	// Orbits that come back within PERIOD_TOLERANCE pixel spacings of an
+	// earlier point are taken to be periodic, hence bounded
+	const flt_t PERIOD_TOLERANCE = 1.e-3L;
+
+	/*
+		Brent's cycle detection: z is saved after iterations 2^k - 1 and every
+		later z compared with the last one saved, so any period p is found
+		within about 2p iterations of the orbit settling into it
+	*/
+	inline bool IsPeriodSave(int_t iteration) {
+		return ((iteration + 1) & iteration) == 0;
+	}
+
+	// Source:
+	//    https://en.wikipedia.org/wiki/Plotting_algorithms_for_the_Mandelbrot_set#Cardioid_/_bulb_checking
+	//
+	// Interior of z^2 + c only:
+	//    main cardioid:  q (q + (x - 1/4)) < y^2 / 4, with q = (x - 1/4)^2 + y^2
+	//    period-2 bulb:  (x + 1)^2 + y^2 < 1/16
+	template <typename T>
+	bool InCardioidOrBulb(const T& x, const T& y) {
+		T x_4 = x - T(0.25);
+		T y_2 = y * y;
+		T q = x_4 * x_4 + y_2;
+
+		if (q * (q + x_4) < y_2 * T(0.25))
+			return true;
+
+		T x_1 = x + T(1.0);
+		return x_1 * x_1 + y_2 < T(0.0625);
+	}
+
+	// Runs one orbit of z^N + c from iteration start to escape or
+	// max_iterations in precision T, leaving z where it ended; STOPPED at
+	// the maximum. period_tolerance is squared; zero turns periodicity
+	// checking off
+	template <typename T, int_t N>
+	escape_t PowerOrbit(Complex<T>& z, Complex<T> c, int_t start, int_t max_iterations, threshold_t threshold, T period_tolerance) {
+		const T bailout = T(threshold * threshold);
+		Complex<T> saved = z;
+
+		for (int_t iteration = start; iteration < max_iterations; ++iteration) {
+			z = c + ipow<N>(z);
+			auto norm = sq_sum(z);
+
+			if (norm > bailout)
+				return escape_t{ iteration, static_cast<double>(norm) };
+
+			if (sq_sum(z - saved) < period_tolerance)
+				return BOUNDED;
+
+			if (IsPeriodSave(iteration))
+				saved = z;
+		}
+
+		return STOPPED;
+	}
+
+	template <typename T>
+	orbit_f<T> PowerOrbitByOrder(int_t order) {
+		static const orbit_f<T> POWER_ORBITS[] = {
+			  PowerOrbit<T, 2>
+			, PowerOrbit<T, 3>
+			, PowerOrbit<T, 4>
+			, PowerOrbit<T, 5>
+			, PowerOrbit<T, 6>
+			, PowerOrbit<T, 7>
+			, PowerOrbit<T, 8>
+			, PowerOrbit<T, 9>
+		};
+
+		if (order >= MIN_POWER_KERNEL && order <= MAX_POWER_KERNEL)
+			return POWER_ORBITS[order - MIN_POWER_KERNEL];
+
+		return nullptr;
+	}
+
+	enum class Precision {
+		  AUTO
+		, FLOAT
+		, DOUBLE
+		, LONG_DOUBLE
+		, DOUBLE_DOUBLE
+		, PERTURBATION  // double deltas from a BigFloat reference orbit
+	};
+
+	const char* const PRECISION_NAMES[] = {
+		  "Auto"
+		, "Float"
+		, "Double"
+		, "Long Double"
+		, "Double-Double"
+		, "Perturbation"
+	};
+
+	// Orbits stay this many ulps clear of the pixel spacing, to absorb the
+	// rounding error that accumulates over the iterations
+	const flt_t PRECISION_MARGIN = 1024.L;
+
+	Precision SelectPrecision(const Geometry2D& scales);
+
+	// Distance between neighbouring pixel centers, the smaller of the axes
+	flt_t PixelSpacing(const Geometry2D& scales);
+
 	sf::Uint8 min(sf::Uint8 first, sf::Uint8 secnd);
 	sf::Uint8 max(sf::Uint8 first, sf::Uint8 secnd);
 
 	sf::Color HsvToColor(int_t hue, flt_t sat, flt_t val);
 	void ColorToHsv(const sf::Color& color, int_t& hue, flt_t& sat, flt_t& val);
 
-	const char const* const COLOR_SCHEME_NAMES[] = {
+	// HsvToColor(hue, 1, 1), looked up: full saturation and value leave one
+	// color per whole degree of hue
+	sf::Color HueColor(int_t hue);
+
+	const char* const COLOR_SCHEME_NAMES[] = {
 		  "Linear"
 		, "Hyberbolic"
 		, "Logarithmic"
@@ -119,17 +272,25 @@ namespace mnd
 	};
 
 	const color_code_f COLOR_SCHEMES[] = {
-		  [](flt_t v) { return HsvToColor(v + INIT_HUE, 1.f, 1.f); }
-		, [](flt_t v) { return HsvToColor(MAX_HUE / v + INIT_HUE, 1.f, 1.f); }
-		, [](flt_t v) { return HsvToColor(10 * LOG(v) + INIT_HUE, 1.f, 1.f); }
-		, [](flt_t v) { return HsvToColor(100 * sin(v) + INIT_HUE, 1.f, 1.f); }
+		  [](flt_t v) { return HueColor(v + INIT_HUE); }
+		, [](flt_t v) { return HueColor(MAX_HUE / v + INIT_HUE); }
+		, [](flt_t v) { return HueColor(10 * LOG(v) + INIT_HUE); }
+		, [](flt_t v) { return HueColor(100 * sin(v) + INIT_HUE); }
 	};
 
 	constexpr int_t NUM_COLOR_SCHEMES = ARRAY_SIZE(COLOR_SCHEMES);
 
-	int_t EscapeTime(pair_t& z, const pair_t& c, int_t power, int_t iteration, threshold_t threshold, complex_f f);
-	int_t Potential(pair_t& z, const pair_t& c, int_t power, int_t iteration, threshold_t threshold, complex_f f);
-	int_t Dichromatic(pair_t& z, const pair_t& c, int_t power, int_t iteration, threshold_t threshold, complex_f f);
+	int_t EscapeTimeValue(flt_t norm, int_t iteration);
+	int_t PotentialValue(flt_t norm, int_t iteration);
+	int_t DichromaticValue(flt_t norm, int_t iteration);
+
+	// Source:
+	//    https://en.wikipedia.org/wiki/Plotting_algorithms_for_the_Mandelbrot_set#Continuous_(smooth)_coloring
+	//
+	// The continuous iteration count n + 1 - log2(log|z|), exact for z^2 + c;
+	// orbits escaping inside the unit circle, under thresholds below 1, fall
+	// back to the escape time
+	int_t SmoothValue(flt_t norm, int_t iteration);
 
 	const threshold_t THRESHOLDS[] = {
 		  2.L
@@ -154,19 +315,23 @@ namespace mnd
 
 	constexpr int_t NUM_THRESHOLDS = ARRAY_SIZE(THRESHOLDS);
 
-	const char const* const ALGORITHM_NAMES[] = {
+	const char* const ALGORITHM_NAMES[] = {
 		  "Escape Time"
 		, "Potential"
 		, "Dichromatic"
+		, "Smooth"
 	};
 
-	const algorithm_f ALGORITHMS[] = {
-		  EscapeTime
-		, Potential
-		, Dichromatic
+	// Each algorithm maps where an orbit escaped to the value its color
+	// scheme colors, when the pixel is drawn
+	const escape_f ESCAPE_VALUES[] = {
+		  EscapeTimeValue
+		, PotentialValue
+		, DichromaticValue
+		, SmoothValue
 	};
 
-	constexpr int_t NUM_ALGORITHMS = ARRAY_SIZE(ALGORITHMS);
+	constexpr int_t NUM_ALGORITHMS = ARRAY_SIZE(ESCAPE_VALUES);
 
 	complex_f FunctionByOrder(int_t order);
 	std::string PowerUnitFunctionName(int_t power);
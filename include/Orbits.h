@@ -0,0 +1,89 @@
+#pragma once
+#include "Tiles.h"
+#include <atomic>
+#include <new>
+#include <stdint.h>
+#include <vector>
+
+const size_t ORBIT_ALIGNMENT = 64;
+
+// A tile's active list is compacted once 1 / COMPACT_RATIO of it has
+// finished, so each compaction pass pays for itself in removed slots
+const size_t COMPACT_RATIO = 4;
+
+// Cache-line aligned storage, so every array of an OrbitBuffer starts on a
+// vector-register boundary
+template <typename T>
+struct AlignedAllocator {
+	typedef T value_type;
+
+	AlignedAllocator() = default;
+
+	template <typename U>
+	AlignedAllocator(const AlignedAllocator<U>&) {}
+
+	T* allocate(size_t n) {
+		return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(ORBIT_ALIGNMENT)));
+	}
+
+	void deallocate(T* p, size_t) {
+		::operator delete(p, std::align_val_t(ORBIT_ALIGNMENT));
+	}
+
+	template <typename U>
+	bool operator==(const AlignedAllocator<U>&) const { return true; }
+
+	template <typename U>
+	bool operator!=(const AlignedAllocator<U>&) const { return false; }
+};
+
+template <typename T>
+using aligned_vector = std::vector<T, AlignedAllocator<T>>;
+
+typedef uint32_t slot_t;
+
+// Orbit state of every pixel of a progressive render, one array per field.
+// Slots are laid out tile by tile, row-major within each tile, so the pixels
+// a worker visits are contiguous. Each tile keeps the slots still iterating
+// in its active list; finished slots linger there until the next compaction.
+class OrbitBuffer {
+private:
+	std::vector<size_t> _offsets;
+	std::vector<std::vector<slot_t>> _active;
+	std::vector<size_t> _finished;
+	std::atomic<size_t> _remaining;
+public:
+	aligned_vector<flt_t> z_re;
+	aligned_vector<flt_t> z_im;
+	aligned_vector<flt_t> saved_re;    // z last saved for cycle detection
+	aligned_vector<flt_t> saved_im;
+	aligned_vector<int_t> iterations;  // iteration the orbit escaped or repeated at, -1 while active
+	aligned_vector<int32_t> x;
+	aligned_vector<int32_t> y;
+
+	OrbitBuffer();
+	OrbitBuffer(const OrbitBuffer&) = delete;
+	OrbitBuffer& operator=(const OrbitBuffer&) = delete;
+
+	void layout(const TileScheduler& tiles);
+	void clear();
+
+	// Marks every slot of the tile active with z = 0
+	void reset(size_t tile);
+
+	// Records that count more slots of the tile finished, compacting its
+	// active list when enough have. Only the tile's current owner may call
+	void finish(size_t tile, size_t count);
+	void compact(size_t tile);
+
+	// Slots not yet finished, across all tiles
+	size_t remaining() const;
+
+	size_t size() const;
+	size_t tiles() const;
+	size_t begin(size_t tile) const;
+	size_t end(size_t tile) const;
+
+	std::vector<slot_t>& active(size_t tile);
+	const std::vector<slot_t>& active(size_t tile) const;
+};
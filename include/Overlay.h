@@ -10,7 +10,7 @@ const char* const DEFAULT_TITLE = "Mandelbrot Set";
 const int_t DISPLAY_PRECISION = 3;
 
 const int_t INPUT_BOX_X = 0;
-const int_t INPUT_BOX_Y = 245;
+const int_t INPUT_BOX_Y = 265;
 const int_t INPUT_BOX_FONT_POINT = 20;
 
 class Overlay : public MenuBox {
@@ -28,6 +28,7 @@ private:
 		, POWER
 		, MAGNIFICATION
 		, ITERATION
+		, REMAINING
 		, THRESHOLD
 		, ALGORITHM
 		, COLOR_SCHEME
@@ -63,6 +64,7 @@ public:
 	Overlay& magnification(int_t value);
 	Overlay& iteration(int_t it);
 	Overlay& iteration(int_t it, int_t max);
+	Overlay& remaining(int_t count);
 	Overlay& threshold(int_t value);
 	Overlay& algorithm(int_t value);
 	Overlay& color_scheme(int_t value);
@@ -85,7 +87,7 @@ public:
 	virtual void draw_to(target_t& canvas) override;
 	virtual void draw_to(canvas_t& canvas) override;
 	OrderedPair<int_t> get_position() const;
-	model_t get_boundaries(const Geometry2D& geo) const;
+	deep_model_t get_boundaries(const DeepGeometry2D& geo) const;
 
 	static int_t factor;
 };
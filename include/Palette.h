@@ -0,0 +1,36 @@
+#pragma once
+#include "Mandelbrot.h"
+#include <vector>
+
+// Escape values colored by lookup for a render to max_iterations: every
+// escape time it can give
+inline int_t PaletteSize(int_t max_iterations) {
+	return mnd::ESCAPE_BIAS * max_iterations + 1LL;
+}
+
+// A color scheme tabulated once over the escape values [0, size), so
+// coloring a pixel is one load. The algorithm's escape value of each pixel
+// is taken as it is drawn, so either can change without iterating again.
+// Larger values, common only to the potential algorithm, call the scheme
+// itself
+class Palette {
+private:
+	mnd::color_code_f _color;
+	mnd::escape_f _escape;
+	std::vector<sf::Color> _colors;
+public:
+	Palette(mnd::color_code_f color, mnd::escape_f escape, int_t size);
+
+	// INIT_COLOR for orbits that stay bounded, and negative escape values
+	sf::Color color(const escape_t& escape) const {
+		auto value = escape.iteration < 0LL ? -1LL : _escape(escape.norm, escape.iteration);
+
+		if (value < 0LL)
+			return mnd::INIT_COLOR;
+
+		if (value < TO_INT(_colors.size()))
+			return _colors[static_cast<size_t>(value)];
+
+		return _color(value);
+	}
+};
@@ -0,0 +1,91 @@
+#pragma once
+#include "Mandelbrot.h"
+#include "Threads.h"
+#include <vector>
+
+// Source:
+//    K. I. Martin, "Superfractalthing Maths" (2013)
+//    Zhuoran, "Another solution to perturbation glitches", fractalforums.org (2021)
+//
+// Only one orbit, the reference, is iterated at full precision; every pixel
+// iterates its small difference from it in double:
+//
+//    z = Z + d,  c = C + dc
+//    d' = (Z + d)^2 + C + dc - (Z^2 + C) = (2Z + d) d + dc
+//
+// A pixel whose |z| falls below |d| is about to lose its precision to
+// cancellation (a glitch); it is rebased onto the start of the reference
+// instead, as it is when it outlives an escaping reference.
+
+typedef Complex<double> delta_t;
+
+// The z^2 + c orbit of one point in precision R, kept rounded to double;
+// cut short when control is cancelled
+class ReferenceOrbit {
+private:
+	std::vector<delta_t> _orbit;
+public:
+	template <typename R>
+	void compute(const Control& control, Complex<R> z, const Complex<R>& c, int_t max_iterations, threshold_t threshold) {
+		const R bailout = R(threshold * threshold);
+
+		_orbit.clear();
+		_orbit.reserve(max_iterations + 1);
+		_orbit.push_back(delta_t{ static_cast<double>(z.re()), static_cast<double>(z.im()) });
+
+		for (int_t iteration = 0; iteration < max_iterations && control.running(); ++iteration) {
+			z = c + sq(z);
+			_orbit.push_back(delta_t{ static_cast<double>(z.re()), static_cast<double>(z.im()) });
+
+			if (sq_sum(z) > bailout)
+				break;
+		}
+	}
+
+	size_t size() const;
+	const delta_t& operator[](size_t n) const;
+};
+
+// Relative error of the series, at every probe, below which its skip holds
+const double SERIES_TOLERANCE = 1.e-13;
+
+// Source:
+//    K. I. Martin, "Superfractalthing Maths" (2013)
+//
+// While d is small it is close to a cubic in the pixel's offset e (dc, or
+// d0 for Julia sets), whose coefficients follow the reference alone:
+//
+//    d_n ~ A_n e + B_n e^2 + C_n e^3
+//    A' = 2ZA + 1,  B' = 2ZB + A^2,  C' = 2ZC + 2AB   (A_0 = 0)
+//    Julia: A' = 2ZA, A_0 = 1
+//
+// so all pixels start at the last iteration where the cubic still matches
+// the exact orbits of the probes, the view's corners
+class SeriesApproximation {
+private:
+	int_t _skip;
+	delta_t _a;
+	delta_t _b;
+	delta_t _c;
+public:
+	SeriesApproximation();
+
+	void compute(const ReferenceOrbit& reference, bool julia, const std::vector<delta_t>& probes, threshold_t threshold);
+
+	// Iterations every pixel may skip
+	int_t skip() const;
+
+	// d after skip() iterations for the pixel at offset
+	delta_t at(const delta_t& offset) const;
+};
+
+// Iterates z^2 + c for the pixel at d, dc from the reference's z and c
+// after iteration start
+escape_t PerturbedOrbit(
+	const ReferenceOrbit& reference,
+	delta_t d,
+	const delta_t& dc,
+	int_t start,
+	int_t max_iterations,
+	threshold_t threshold
+);
@@ -0,0 +1,49 @@
+#pragma once
+#include "Mandelbrot.h"
+#include "Palette.h"
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+// The last frame of a view resampled, nearest pixel, into a view zoomed in
+// from it: shown at once while the new view renders. A pixel whose
+// coordinates equal an old pixel's, as every orbit type rounds them,
+// iterates the same orbit; so when the old frame holds finished results of
+// the same arithmetic (reusable), the pixels it saw escape are known() and
+// need not be iterated again: their escapes carry over. Over the same view
+// under a higher maximum, the orbits the old frame stopped go on too.
+// Escapes kept on disk are known as well, bounded ones included
+class Preview {
+private:
+	sf::Image _image;
+	std::vector<escape_t> _values;  // BOUNDED where not known
+	std::vector<bool> _known;
+	int_t _width;
+	std::vector<stopped_t> _stopped;
+	std::vector<uint32_t> _stopped_index;  // one past the pixel's orbit in _stopped, 0 where none
+	int_t _stopped_at;
+public:
+	Preview(const sf::Image& image, const std::vector<escape_t>& values, const Geometry2D& from, const Geometry2D& to, bool reusable);
+
+	// Nothing to show or known yet
+	Preview(int_t width, int_t height);
+
+	// Escapes of the same view found elsewhere, colored in where known
+	void know(const std::vector<escape_t>& values, const std::vector<bool>& known, const Palette& palette);
+
+	// Orbits a finished render of the same view, in the same arithmetic,
+	// stopped at iteration
+	void resume(const std::vector<stopped_t>& orbits, int_t iteration);
+
+	const sf::Image& image() const;
+	const std::vector<escape_t>& values() const;
+	bool known(int_t x, int_t y) const;
+	const escape_t& value(int_t x, int_t y) const;
+
+	// z where the pixel's orbit stopped, null where it did not
+	const pair_t* stopped(int_t x, int_t y) const;
+	int_t stopped_at() const;
+};
+
+typedef std::shared_ptr<const Preview> preview_ptr;
@@ -1,57 +1,176 @@
 #pragma once
+#include "Frames.h"
 #include "Mandelbrot.h"
-#include "Overlay.h"
+#include "Orbits.h"
+#include "Palette.h"
+#include "Perturbation.h"
+#include "Preview.h"
+#include "Simd.h"
 #include "State.h"
 #include "Threads.h"
+#include "Tiles.h"
 
-typedef pair_t* plot_t;
+class Overlay;
+
+typedef std::function<void(int_t)> iteration_f;
+
+// Escapes of count pixels, BOUNDED where the orbit stays bounded, computed
+// by the pool worker given
+typedef std::function<void(size_t worker, const int_t* xs, const int_t* ys, size_t count, escape_t* values)> values_f;
+
+// Iterations of one pixel between checks for cancellation, for functions
+// slow enough that a single orbit outlasts a click
+const int_t CANCEL_INTERVAL = 1024LL;
+
+enum class RenderMode {
+	  PROGRESSIVE     // one iteration of every pixel per frame, for recordings
+	, PIXEL_MAJOR     // each pixel iterated to escape in one pass, for final renders
+	, COARSE_TO_FINE  // pixel-major passes at rising resolution, for interactive use
+};
+
+// Pixels between the samples of each coarse-to-fine pass, so 1/16, 1/4 and
+// then all of them. Each pass colors the block up to its next samples and
+// skips the samples of the pass before
+const int_t PASS_STEPS[] = { 4LL, 2LL, 1LL };
+
+// Subdivided rectangles at most this many pixels across are computed
+// instead of split again
+const int_t MIN_SUBDIVISION = 4LL;
+
+// Pixels across the blocks subdivision starts from; the rectangles split
+// from them are shared between workers by stealing
+const int_t SUBDIVISION_BLOCK = 128LL;
 
 class Renderer {
 private:
-	typedef bool(Renderer::* color_pixel_f)(sf::Image&, int_t x, int_t y);
+	typedef bool(Renderer::* color_pixel_f)(sf::Image&, slot_t slot);
 	color_pixel_f _color_pixel_method;
 
+	RenderMode _mode;
+	mnd::Precision _precision;
 	int_t _type;
+	DeepGeometry2D _deep_scales;
 	Geometry2D _scales;
 	view_t _view;
 	int_t _iteration;
 	int_t _max_iterations;
+	int_t _step;
+	int_t _skip;
 	int_t _power;
 	threshold_t _threshold;
+	flt_t _period_tolerance;
+	bool _bulbs;
+	bool _subdivide;
 	pair_t _j_coords;
-	plot_t _plot;
-	std::reference_wrapper<sf::Image> _image;
-	std::reference_wrapper<Overlay> _display;
+	OrbitBuffer _orbits;
+	std::reference_wrapper<FrameBuffer> _frames;
+	iteration_f _on_iteration;
+	iteration_f _on_remaining;
 	mnd::complex_f _fnc;
-	mnd::color_code_f _col;
-	mnd::algorithm_f _alg;
+	Palette _palette;
+	control_ptr _control;
+	preview_ptr _preview;
+	ReferenceOrbit _reference;
+	SeriesApproximation _series;
+	ThreadPool _pool;
+	TileScheduler _tiles;
+	std::vector<std::vector<stopped_t>> _stopped;  // by worker, over every pass
+
+	int_t FirstSample(int_t pixel) const;
+	bool Taken(int_t x, int_t y) const;
+	void Plot(sf::Image& someImage, int_t x, int_t y, const escape_t& value);
+	bool PlotKnown(sf::Image& someImage, int_t x, int_t y);
+
+	bool PlotValue(sf::Image& someImage, int_t x, int_t y, const escape_t& value);
 
-	bool ColorPixel(sf::Image& someImage, int_t x, int_t y, pair_t c);
-	bool ColorMandelbrotPixel(sf::Image& someImage, int_t x, int_t y);
-	bool ColorJuliaPixel(sf::Image& someImage, int_t x, int_t y);
+	bool ColorPixel(sf::Image& someImage, slot_t slot, pair_t c);
+	bool ColorMandelbrotPixel(sf::Image& someImage, slot_t slot);
+	bool ColorJuliaPixel(sf::Image& someImage, slot_t slot);
+	escape_t OrbitValue(int_t x, int_t y);
+	void SeedFromPreview(sf::Image& someImage);
+	int ClearActive(sf::Image& someImage);
+	void KeepStopped();
 	int RenderFrame(sf::Image& someImage);
+	int RenderOrbits(sf::Image& someImage);
+
+	template <typename F>
+	int RenderTiles(F draw);
+
+	int RenderRows(sf::Image& someImage, const values_f& values);
+	int RenderSubdivided(sf::Image& someImage, const values_f& values);
+
+	template <typename T>
+	escape_t Stop(size_t worker, int_t x, int_t y, const escape_t& escape, const Complex<T>& z);
+
+	template <typename T>
+	values_f PowerValues();
+
+	template <typename T>
+	values_f VectorValues(simd::kernel_f<T> kernel);
+
+	template <typename T>
+	values_f TypedValues();
+
+	values_f PerturbedValues();
+	values_f OrbitValues();
 public:
 	Renderer(
-		std::reference_wrapper<sf::Image>,
+		std::reference_wrapper<FrameBuffer>,
 		std::reference_wrapper<Overlay>,
 		const State&
 	);
 
-	sf::Image Start();
+	// Headless: no overlay is notified of the iteration count
+	Renderer(
+		std::reference_wrapper<FrameBuffer>,
+		const State&
+	);
+
+	RenderMode mode() const;
+	Renderer& mode(RenderMode value);
+
+	// Numeric type of pixel-major power orbits; AUTO picks the cheapest one
+	// adequate for the pixel spacing, and perturbation for z^2 + c past
+	// long double. Other functions and progressive rendering iterate in flt_t
+	mnd::Precision precision() const;
+	Renderer& precision(mnd::Precision value);
+
+	// The render's cancellation token; workers check it at every tile, row
+	// and pixel, and every CANCEL_INTERVAL iterations of a pixel
+	const control_ptr& control() const;
+	Renderer& control(const control_ptr& value);
+
+	// Progressive and coarse-to-fine renders skip the pixels the preview
+	// knows, and paint INIT_COLOR over it where orbits do not escape. The
+	// caller fills the FrameBuffer with the preview's image and values.
+	// Pixel-major power orbits the preview kept stopped go on from there,
+	// and a finished render hands the FrameBuffer those it stopped
+	const preview_ptr& preview() const;
+	Renderer& preview(const preview_ptr& value);
+
+	// Full-resolution pixel-major passes trace rectangle borders and fill
+	// rectangles bounded by one escape iteration instead of computing them.
+	// Exact inside the set; elsewhere a thin band can be filled over. Only
+	// power orbits with a threshold of at least 2 subdivide; others go by rows
+	bool subdivide() const;
+	Renderer& subdivide(bool value);
+
+	void Start();
 	bool HasNext();
-	void Next(sf::Image& someImage);
+	void Next();
 	void Close();
 	void Run();
 
 	class Interruptible {
 	public:
-		static void InitializePlot(plot_t& plot, const view_t& view);
-		static void InitializeJulia(plot_t& plot, const view_t& view, const Geometry2D& scales);
+		static void InitializePlot(const Control& control, OrbitBuffer& orbits, const Geometry2D& scales, bool bulbs);
+		static void InitializeJulia(const Control& control, OrbitBuffer& orbits, const Geometry2D& scales);
 	};
 
 	class Threads {
 	public:
-		static volatile std::atomic<bool> rendering;
-		static volatile std::atomic<bool> paused;
+		// Number of render workers; zero means one per hardware thread
+		static size_t workers;
+		static size_t count();
 	};
 };
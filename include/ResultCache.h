@@ -0,0 +1,54 @@
+#pragma once
+#include "State.h"
+#include <list>
+#include <vector>
+
+// Memory the cache may hold in escapes, about 15 views of 1200x900
+const size_t DEFAULT_CACHE_BYTES = 256 << 20;
+
+// The fields of a State its escapes depend on; the algorithm and color
+// scheme only map them, and magnification only counts zooms
+struct RenderKey {
+	view_t view;
+	deep_model_t model;
+	int_t type;
+	pair_t j_coords;
+	int_t power;
+	int_t threshold;
+	int_t max_iterations;
+	size_t hash;
+
+	RenderKey(const State& state);
+	bool operator==(const RenderKey& other) const;
+};
+
+// The escapes of finished renders, so returning to a view shows it
+// at once. The least recently used views are dropped past the budget
+class ResultCache {
+private:
+	struct Entry {
+		RenderKey key;
+		std::vector<escape_t> values;
+	};
+
+	size_t _budget;
+	size_t _bytes;
+	std::list<Entry> _entries;  // most recently used first
+
+	void trim();
+public:
+	ResultCache(size_t budget = DEFAULT_CACHE_BYTES);
+
+	// Lowering the budget drops the least recently used views past it
+	size_t budget() const;
+	ResultCache& budget(size_t bytes);
+	size_t bytes() const;
+
+	// The values of the state's view, null when not cached; valid until the
+	// next add()
+	const std::vector<escape_t>* find(const State& state);
+
+	// False, and the entry only made the most recent, when already cached
+	bool add(const State& state, const std::vector<escape_t>& values);
+	void clear();
+};
@@ -0,0 +1,67 @@
+#pragma once
+#include "types.h"
+#include <stddef.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86
+#endif
+
+// Explicitly vectorized z^N + c orbits, for N in [MIN_ORDER, MAX_ORDER],
+// selected at runtime from the instruction sets the CPU supports
+namespace simd
+{
+	enum class Isa {
+		  SCALAR
+		, AVX2
+		, AVX512
+	};
+
+	const char* const ISA_NAMES[] = {
+		  "Scalar"
+		, "AVX2"
+		, "AVX-512"
+	};
+
+	const int_t MIN_ORDER = 2LL;
+	const int_t MAX_ORDER = 9LL;
+
+	// Highest instruction set that may be used; lowered to compare kernels
+	extern Isa limit;
+
+	// Best instruction set both the CPU and the OS support
+	Isa Detect();
+
+	// Lesser of Detect() and limit
+	Isa Active();
+
+	template <typename T>
+	struct OrbitParams {
+		int_t max_iterations;
+		T bailout;      // squared escape threshold
+		bool julia;     // pixels are z0 and c is j_coords, instead of z0 = 0
+		T j_re;
+		T j_im;
+		T period_tolerance;  // squared, as for mnd::PowerOrbit
+		bool bulbs;     // skip pixels in the main cardioid and period-2 bulb
+	};
+
+	// Iteration of the pixels still iterating at the maximum
+	const int_t STOPPED = -2LL;
+
+	// Iterates count pixels with coordinates (re[i], im[i]), writing the
+	// iteration each escaped at and |z|^2 there, -1 where it repeated, or
+	// STOPPED and z where it reached the maximum
+	template <typename T>
+	using kernel_f = void(*)(const OrbitParams<T>& params, const T* re, const T* im, size_t count, int_t* iterations, T* norms, T* z_re, T* z_im);
+
+	// Kernel of the active instruction set, or nullptr when there is no
+	// vector kernel for it and the caller should iterate scalars
+	template <typename T>
+	kernel_f<T> KernelByOrder(int_t order);
+
+	template <>
+	kernel_f<float> KernelByOrder<float>(int_t order);
+
+	template <>
+	kernel_f<double> KernelByOrder<double>(int_t order);
+};
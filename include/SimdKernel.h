@@ -0,0 +1,204 @@
+#pragma once
+#include "Simd.h"
+
+// Lane-generic orbit kernel, included only by the translation units built
+// for one instruction set each (SimdAvx2.cpp, SimdAvx512.cpp). V wraps one
+// vector register type:
+//
+//    scalar_t, vec_t, LANES
+//    load(const scalar_t*), store(scalar_t*, vec_t), set1(scalar_t)
+//    add(vec_t, vec_t), sub(vec_t, vec_t), mul(vec_t, vec_t)
+//    greater(vec_t, vec_t) -> int, one bit per lane
+//
+// The arithmetic follows Complex<T>, sq and ipow operation for operation,
+// so each lane rounds exactly as the scalar orbit does
+namespace simd
+{
+	template <typename V>
+	struct Lanes {
+		typename V::vec_t re;
+		typename V::vec_t im;
+	};
+
+	/*
+		(a + bi)^2 = (a^2 - b^2) + 2abi
+	*/
+	template <typename V>
+	Lanes<V> sq(const Lanes<V>& z) {
+		return Lanes<V>{
+			V::sub(V::mul(z.re, z.re), V::mul(z.im, z.im)),
+			V::mul(V::mul(V::set1(2), z.re), z.im)
+		};
+	}
+
+	template <typename V>
+	Lanes<V> mul(const Lanes<V>& z, const Lanes<V>& w) {
+		return Lanes<V>{
+			V::sub(V::mul(z.re, w.re), V::mul(z.im, w.im)),
+			V::add(V::mul(z.re, w.im), V::mul(z.im, w.re))
+		};
+	}
+
+	template <int_t N, typename V>
+	Lanes<V> ipow(const Lanes<V>& z) {
+		if constexpr (N == 1)
+			return z;
+		else if constexpr (N % 2 == 0)
+			return sq(ipow<N / 2>(z));
+		else
+			return mul(z, sq(ipow<N / 2>(z)));
+	}
+
+	// mnd::InCardioidOrBulb, repeated here so that no inline function is
+	// instantiated both in and out of an instruction-set translation unit
+	template <typename V>
+	bool InCardioidOrBulb(typename V::scalar_t x, typename V::scalar_t y) {
+		typedef typename V::scalar_t T;
+
+		T x_4 = x - T(0.25);
+		T y_2 = y * y;
+		T q = x_4 * x_4 + y_2;
+
+		if (q * (q + x_4) < y_2 * T(0.25))
+			return true;
+
+		T x_1 = x + T(1.0);
+		return x_1 * x_1 + y_2 < T(0.0625);
+	}
+
+	// Each group of LANES pixels runs until its last lane escapes or repeats
+	// (Brent, as mnd::PowerOrbit); a short final group repeats its last pixel
+	// so the padding finishes with it
+	template <typename V, int_t N>
+	void LaneOrbits(
+		const OrbitParams<typename V::scalar_t>& params,
+		const typename V::scalar_t* re,
+		const typename V::scalar_t* im,
+		size_t count,
+		int_t* iterations,
+		typename V::scalar_t* norms,
+		typename V::scalar_t* z_re,
+		typename V::scalar_t* z_im
+	) {
+		typedef typename V::scalar_t T;
+
+		alignas(64) T pad_re[V::LANES];
+		alignas(64) T pad_im[V::LANES];
+		alignas(64) T norm[V::LANES];
+		alignas(64) T last_re[V::LANES];
+		alignas(64) T last_im[V::LANES];
+
+		const auto bailout = V::set1(params.bailout);
+		const auto tolerance = V::set1(params.period_tolerance);
+
+		for (size_t i = 0; i < count; i += V::LANES) {
+			size_t lanes = count - i < V::LANES ? count - i : V::LANES;
+			const T* lane_re = re + i;
+			const T* lane_im = im + i;
+
+			if (lanes < V::LANES) {
+				for (size_t l = 0; l < V::LANES; ++l) {
+					pad_re[l] = lane_re[l < lanes ? l : lanes - 1];
+					pad_im[l] = lane_im[l < lanes ? l : lanes - 1];
+				}
+
+				lane_re = pad_re;
+				lane_im = pad_im;
+			}
+
+			Lanes<V> pixel{ V::load(lane_re), V::load(lane_im) };
+			Lanes<V> z, c;
+
+			if (params.julia) {
+				z = pixel;
+				c = Lanes<V>{ V::set1(params.j_re), V::set1(params.j_im) };
+			}
+			else {
+				z = Lanes<V>{ V::set1(0), V::set1(0) };
+				c = pixel;
+			}
+
+			int active = (1 << lanes) - 1;
+
+			for (size_t l = 0; l < lanes; ++l) {
+				iterations[i + l] = -1LL;
+
+				if (params.bulbs && InCardioidOrBulb<V>(lane_re[l], lane_im[l]))
+					active &= ~(1 << l);
+			}
+
+			Lanes<V> saved = z;
+
+			for (int_t iteration = 0; active && iteration < params.max_iterations; ++iteration) {
+				auto p = ipow<N>(z);
+				z = Lanes<V>{ V::add(c.re, p.re), V::add(c.im, p.im) };
+
+				auto n = V::add(V::mul(z.re, z.re), V::mul(z.im, z.im));
+				int escaped = V::greater(n, bailout) & active;
+
+				auto d_re = V::sub(z.re, saved.re);
+				auto d_im = V::sub(z.im, saved.im);
+				active &= ~V::greater(tolerance, V::add(V::mul(d_re, d_re), V::mul(d_im, d_im))) | escaped;
+
+				if (((iteration + 1) & iteration) == 0)
+					saved = z;
+
+				if (escaped) {
+					V::store(norm, n);
+					active &= ~escaped;
+
+					for (size_t l = 0; l < lanes; ++l) {
+						if (escaped & (1 << l)) {
+							iterations[i + l] = iteration;
+							norms[i + l] = norm[l];
+						}
+					}
+				}
+			}
+
+			// Lanes still active ran out of iterations
+			if (active) {
+				V::store(last_re, z.re);
+				V::store(last_im, z.im);
+
+				for (size_t l = 0; l < lanes; ++l) {
+					if (active & (1 << l)) {
+						iterations[i + l] = STOPPED;
+						z_re[i + l] = last_re[l];
+						z_im[i + l] = last_im[l];
+					}
+				}
+			}
+		}
+	}
+
+	template <typename V>
+	struct KernelTable {
+		static const kernel_f<typename V::scalar_t> KERNELS[MAX_ORDER - MIN_ORDER + 1];
+	};
+
+	template <typename V>
+	const kernel_f<typename V::scalar_t> KernelTable<V>::KERNELS[MAX_ORDER - MIN_ORDER + 1] = {
+		  LaneOrbits<V, 2>
+		, LaneOrbits<V, 3>
+		, LaneOrbits<V, 4>
+		, LaneOrbits<V, 5>
+		, LaneOrbits<V, 6>
+		, LaneOrbits<V, 7>
+		, LaneOrbits<V, 8>
+		, LaneOrbits<V, 9>
+	};
+
+	// Defined in the translation unit of each instruction set
+	namespace avx2
+	{
+		kernel_f<float> KernelByOrder(int_t order, float);
+		kernel_f<double> KernelByOrder(int_t order, double);
+	};
+
+	namespace avx512
+	{
+		kernel_f<float> KernelByOrder(int_t order, float);
+		kernel_f<double> KernelByOrder(int_t order, double);
+	};
+};
@@ -1,5 +1,7 @@
 #pragma once
 #include "Mandelbrot.h"
+#include "Palette.h"
+#include "Save.h"
 #include <stack>
 
 const model_t INIT_MODEL = AssertNewBounds<flt_t>(-2.5L, 1.5L, -1.5L, 1.5L);
@@ -19,12 +21,13 @@ const pair_t INIT_PAIR = { 0.L, 0.L };
 const int_t DEFAULT_ALGORITHM_INDEX = 0LL;
 const int_t DEFAULT_COLOR_SCHEME_INDEX = 0LL;
 
-typedef std::stack<model_t> model_stack_t;
+typedef std::stack<deep_model_t> model_stack_t;
 
 int_t min_power();
 model_stack_t init_model_stack();
-model_stack_t push(model_stack_t models, model_t model);
+model_stack_t push(model_stack_t models, deep_model_t model);
 model_stack_t pop(model_stack_t models);
+deep_model_t zoom_box(const DeepGeometry2D& geo, int_t x, int_t y, int_t width, int_t height);
 
 struct State {
 public:
@@ -54,6 +57,7 @@ public:
 	State& new_model_stack(const model_stack_t& value);
 	State& init_model_stack();
 	State& push_model(model_t value);
+	State& push_model(deep_model_t value);
 	State& pop_model();
 
 	State& new_type(int_t value);
@@ -82,4 +86,15 @@ public:
 	State& new_color_scheme(int_t value);
 	State& next_color_scheme();
 	State& prev_color_scheme();
+
+	DeepGeometry2D geometry() const;
+	pair_t center() const;
+
+	// The color scheme and algorithm, tabulated over the escape times of
+	// max_iterations
+	Palette palette() const;
+	State& zoom_in(pair_t coords, int_t factor = DEFAULT_ZOOM);
+	State& zoom_out();
+	State& go_to(const std::string& str, int_t factor = DEFAULT_ZOOM);
+	std::string file_name(int_t iteration) const;
 };
@@ -1,6 +1,9 @@
 #pragma once
 #include <atomic>
+#include <condition_variable>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -17,3 +20,59 @@ public:
 	static volatile std::atomic<bool> delay_next_poll;
 	static volatile std::atomic<bool> notifying;
 };
+
+// A cancellation token, one per piece of work, shared by the thread that
+// pauses and cancels it and the workers doing it. Workers poll running()
+// and call wait() between pieces of work, where a paused worker sleeps on
+// a condition variable until resume() or cancel() instead of spinning.
+// Cancelling is final
+class Control {
+private:
+	std::mutex _mutex;
+	std::condition_variable _resumed;
+	std::atomic<bool> _running;
+	std::atomic<bool> _paused;
+public:
+	Control();
+	Control(const Control&) = delete;
+	Control& operator=(const Control&) = delete;
+
+	void cancel();
+	bool running() const;
+
+	// Returns whether it was paused before, for the caller to restore
+	bool pause(bool value = true);
+	void resume();
+	bool paused() const;
+
+	// Blocks while paused and running; returns running()
+	bool wait();
+};
+
+typedef std::shared_ptr<Control> control_ptr;
+
+// Long-lived workers that all run the same task once per call to Run;
+// Run returns only after every worker has finished (a barrier)
+class ThreadPool {
+public:
+	typedef std::function<void(size_t)> task_f;
+private:
+	std::vector<std::thread> _workers;
+	std::mutex _mutex;
+	std::condition_variable _started;
+	std::condition_variable _finished;
+	task_f _task;
+	size_t _generation;
+	size_t _pending;
+	bool _stopping;
+
+	void Work(size_t index);
+public:
+	ThreadPool(size_t count);
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	virtual ~ThreadPool();
+
+	size_t size() const;
+	void Run(const task_f& task);
+};
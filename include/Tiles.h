@@ -0,0 +1,77 @@
+#pragma once
+#include "Geometry.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+const int_t DEFAULT_TILE_SIZE = 32LL;
+
+// Splits a view into square tiles and deals them out to workers. Each worker
+// starts on its own contiguous run of tiles, then steals from the runs of the
+// others once its own is exhausted, so no worker idles while tiles remain.
+class TileScheduler {
+private:
+	// One cache line per run keeps the owners' counters from false sharing
+	struct alignas(64) Run {
+		std::atomic<size_t> next;
+		size_t begin;
+		size_t end;
+	};
+
+	std::vector<view_t> _tiles;
+	std::vector<Run> _runs;
+public:
+	TileScheduler(const view_t& view, size_t workers, int_t tile_size = DEFAULT_TILE_SIZE);
+	TileScheduler(const TileScheduler&) = delete;
+	TileScheduler& operator=(const TileScheduler&) = delete;
+
+	size_t size() const;
+	size_t workers() const;
+	void reset();
+	bool next(size_t worker, view_t& tile);
+	bool next(size_t worker, size_t& index);
+	const view_t& tile(size_t index) const;
+};
+
+// Rectangles dealt out to workers as they are split. Each worker pushes and
+// pops at the back of its own deque, so it keeps to the newest and smallest
+// rectangles, and once that is empty steals from the front of the others',
+// where the oldest and largest wait. An idle worker sleeps until a rectangle
+// is pushed; pop() returns false once none is queued or being worked on,
+// since only a worker holding one can push more, or after close()
+class RectangleQueue {
+private:
+	// One cache line per deque keeps the owners' locks from false sharing
+	struct alignas(64) Deque {
+		std::mutex mutex;
+		std::deque<view_t> rects;
+	};
+
+	std::vector<Deque> _deques;
+	std::atomic<size_t> _queued;
+	std::atomic<size_t> _pending;  // queued or popped and not yet finished
+	std::atomic<bool> _closed;
+	std::atomic<size_t> _waiting;
+	std::mutex _mutex;
+	std::condition_variable _idle;
+
+	bool take(size_t worker, view_t& rect);
+	void notify(bool all);
+public:
+	RectangleQueue(size_t workers);
+	RectangleQueue(const RectangleQueue&) = delete;
+	RectangleQueue& operator=(const RectangleQueue&) = delete;
+
+	void push(size_t worker, const view_t& rect);
+
+	// Blocks until a rectangle is taken or there is nothing left to take;
+	// each rectangle taken is finish()ed after any rectangles split from it
+	// are pushed
+	bool pop(size_t worker, view_t& rect);
+	void finish();
+
+	// Wakes every worker and hands out nothing more, for cancellation
+	void close();
+};
@@ -1,6 +1,11 @@
 #include "pch.h"
 #include "CppUnitTest.h"
+#include "BigFloat.h"
 #include "Complex.h"
+#include "DiskCache.h"
+#include "DoubleDouble.h"
+#include "ResultCache.h"
+#include <filesystem>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -35,6 +40,20 @@ namespace ComplexType
 			Assert::AreEqual(-648.09772f, a_raised.im(), DELTA, L"Imag part of a complex raised by an integer");
 		}
 
+		TEST_METHOD(UnrolledPower)
+		{
+			Assert::AreEqual(pow(a, 2LL).re(), sq(a).re(), DELTA, L"Real part of a complex squared");
+			Assert::AreEqual(pow(a, 2LL).im(), sq(a).im(), DELTA, L"Imag part of a complex squared");
+
+			pair_t a_raised(ipow<5>(a));
+			Assert::AreEqual(pow(a, 5LL).re(), a_raised.re(), 1.0e-12L, L"Real part of a complex raised by an unrolled integer");
+			Assert::AreEqual(pow(a, 5LL).im(), a_raised.im(), 1.0e-12L, L"Imag part of a complex raised by an unrolled integer");
+
+			a_raised = ipow<9>(a);
+			Assert::AreEqual(pow(a, 9LL).re(), a_raised.re(), 1.0e-9L, L"Real part of a complex raised by an unrolled integer");
+			Assert::AreEqual(pow(a, 9LL).im(), a_raised.im(), 1.0e-9L, L"Imag part of a complex raised by an unrolled integer");
+		}
+
 		TEST_METHOD(FractionalPower)
 		{
 			pair_t a_raised(fpow(a, 2.9L));
@@ -47,3 +66,244 @@ namespace ComplexType
 		}
 	};
 }
+
+namespace DoubleDoubleType
+{
+	const double DELTA = 1.0e-30;
+
+	TEST_CLASS(Operations)
+	{
+	public:
+		TEST_METHOD(SumBelowDoubleEpsilon)
+		{
+			dd_t tiny(ldexp(1.0, -80));
+			dd_t difference = (dd_t(1.0) + tiny) - dd_t(1.0);
+			Assert::AreEqual(tiny.hi, difference.hi, 0.0, L"Sum keeps the bits a double drops");
+		}
+
+		TEST_METHOD(ProductCarriesError)
+		{
+			dd_t third = dd_t(1.0 / 3.0);
+			dd_t product = third * dd_t(3.0);
+			Assert::AreEqual(-ldexp(1.0, -54), (product - dd_t(1.0)).hi, DELTA, L"Product rounding error is kept");
+		}
+
+		TEST_METHOD(ComplexSquare)
+		{
+			Complex<dd_t> z(dd_t(1.0), dd_t(ldexp(1.0, -70)));
+			auto squared = sq(z);
+			Assert::AreEqual(ldexp(1.0, -69), squared.im().hi, 0.0, L"Imag part of a double-double complex squared");
+			Assert::IsTrue(squared.re() < dd_t(1.0), L"Real part of a double-double complex squared");
+		}
+	};
+}
+
+namespace BigFloatType
+{
+	const long double DELTA = 1.0e-18L;
+
+	TEST_CLASS(Operations)
+	{
+	public:
+		TEST_METHOD(RoundTrip)
+		{
+			Assert::AreEqual(-0.1L, static_cast<long double>(BigFloat(-0.1L)), 0.0L, L"Long double survives conversion");
+		}
+
+		TEST_METHOD(SumBelowLongDoubleEpsilon)
+		{
+			BigFloat tiny(ldexpl(1.0L, -200));
+			BigFloat difference = (BigFloat(1.0L, 8) + tiny) - BigFloat(1.0L);
+			Assert::AreEqual(ldexpl(1.0L, -200), static_cast<long double>(difference), 0.0L, L"Sum keeps the bits of its longest operand");
+		}
+
+		TEST_METHOD(TruncatedProduct)
+		{
+			BigFloat x = BigFloat(1.0L, 8) + BigFloat(ldexpl(1.0L, -120));
+			BigFloat error = x * x - BigFloat(1.0L) - BigFloat(ldexpl(1.0L, -119));
+			Assert::AreEqual(ldexpl(1.0L, -240), static_cast<long double>(error), 0.0L, L"Product keeps the square of the offset");
+		}
+
+		TEST_METHOD(ComplexSquare)
+		{
+			Complex<BigFloat> z(BigFloat(0.3L, 4), BigFloat(-0.2L, 4));
+			auto squared = sq(z);
+			Assert::AreEqual(0.3L * 0.3L - 0.2L * 0.2L, static_cast<long double>(squared.re()), DELTA, L"Real part of a big complex squared");
+			Assert::AreEqual(2.0L * 0.3L * -0.2L, static_cast<long double>(squared.im()), DELTA, L"Imag part of a big complex squared");
+		}
+
+		TEST_METHOD(LimbsFollowSpacing)
+		{
+			Assert::IsTrue(BigFloat::LimbsForSpacing(1.0e-100L) > BigFloat::LimbsForSpacing(1.0e-10L), L"Deeper spacing needs more limbs");
+			Assert::IsTrue(BigFloat::LimbsForSpacing(0.0L) == MIN_LIMBS, L"Degenerate spacing gets the fewest limbs");
+		}
+	};
+}
+
+namespace ResultCacheType
+{
+	const int_t WIDTH = 8LL;
+	const int_t HEIGHT = 6LL;
+	const size_t VIEW_PIXELS = static_cast<size_t>(WIDTH * HEIGHT);
+	const size_t VIEW_BYTES = VIEW_PIXELS * sizeof(escape_t);
+
+	// Views told apart by their maximum
+	State View(int_t max_iterations) {
+		State state(WIDTH, HEIGHT);
+		state.new_max_iterations(max_iterations);
+		return state;
+	}
+
+	std::vector<escape_t> Values(int_t iteration) {
+		return std::vector<escape_t>(VIEW_PIXELS, escape_t{ iteration, 4.5 });
+	}
+
+	TEST_CLASS(Operations)
+	{
+	public:
+		TEST_METHOD(FindsWhatWasAdded)
+		{
+			ResultCache cache;
+			Assert::IsTrue(cache.add(View(100), Values(7)), L"New view is added");
+			Assert::IsFalse(cache.add(View(100), Values(7)), L"Cached view is not added again");
+
+			auto values = cache.find(View(100));
+			Assert::IsTrue(values != nullptr && (*values)[0].iteration == 7, L"Added view is found");
+			Assert::IsTrue(cache.find(View(200)) == nullptr, L"Other view is not found");
+		}
+
+		TEST_METHOD(DropsLeastRecentlyUsed)
+		{
+			ResultCache cache(2 * VIEW_BYTES);
+			cache.add(View(100), Values(1));
+			cache.add(View(200), Values(2));
+			cache.find(View(100));
+			cache.add(View(300), Values(3));
+
+			Assert::IsTrue(cache.find(View(200)) == nullptr, L"Least recently used view is dropped");
+			Assert::IsTrue(cache.find(View(100)) != nullptr, L"View found since is kept");
+			Assert::IsTrue(cache.find(View(300)) != nullptr, L"Newest view is kept");
+			Assert::IsTrue(cache.bytes() == 2 * VIEW_BYTES, L"Bytes count the views kept");
+		}
+
+		TEST_METHOD(TrimsToLowerBudget)
+		{
+			ResultCache cache(3 * VIEW_BYTES);
+			cache.add(View(100), Values(1));
+			cache.add(View(200), Values(2));
+			cache.add(View(300), Values(3));
+			cache.budget(VIEW_BYTES);
+
+			Assert::IsTrue(cache.bytes() == VIEW_BYTES, L"Lowered budget is kept to");
+			Assert::IsTrue(cache.find(View(300)) != nullptr, L"Most recent view survives trimming");
+			Assert::IsTrue(cache.find(View(100)) == nullptr && cache.find(View(200)) == nullptr, L"Older views are trimmed");
+		}
+	};
+}
+
+namespace DiskCacheType
+{
+	const int_t WIDTH = 64LL;
+	const int_t HEIGHT = 48LL;
+	const int_t PAN = 8LL;
+
+	// Pixels 1/16 apart, the cells of level 4, so a view panned by whole
+	// pixels falls in the same cells; the view spans two tiles each way
+	State View(int_t max_iterations, flt_t left = -2.5L) {
+		State state(WIDTH, HEIGHT);
+		state.new_max_iterations(max_iterations).push_model(model_t{ left, left + 4.L, -1.5L, 1.5L });
+		return state;
+	}
+
+	std::vector<escape_t> Values() {
+		std::vector<escape_t> values;
+
+		for (int_t i = 0; i < WIDTH * HEIGHT; ++i)
+			values.push_back(i % 7 == 0 ? BOUNDED : escape_t{ i, 4.5 + i });
+
+		return values;
+	}
+
+	bool Same(const escape_t& a, const escape_t& b) {
+		return a.iteration == b.iteration && a.norm == b.norm;
+	}
+
+	// Empty for each test
+	std::string Directory() {
+		auto directory = std::filesystem::temp_directory_path() / "mandelbrot-mstest";
+		std::filesystem::remove_all(directory);
+		return directory.string();
+	}
+
+	TEST_CLASS(Operations)
+	{
+	public:
+		TEST_METHOD(RoundTrip)
+		{
+			auto directory = Directory();
+			auto stored = Values();
+
+			{
+				DiskCache cache(directory);
+				cache.store(View(100), stored);
+			}
+
+			DiskCache cache(directory);
+			std::vector<escape_t> values;
+			std::vector<bool> known;
+			auto covered = cache.load(View(100), values, known);
+			bool same = true;
+
+			for (size_t i = 0; i < stored.size(); ++i)
+				same = same && known[i] && Same(values[i], stored[i]);
+
+			Assert::IsTrue(covered == stored.size(), L"Stored view is covered");
+			Assert::IsTrue(same, L"Stored view reads back exactly in a later cache");
+			std::filesystem::remove_all(directory);
+		}
+
+		TEST_METHOD(KeyMismatch)
+		{
+			auto directory = Directory();
+			DiskCache cache(directory);
+			cache.store(View(100), Values());
+			cache.flush();
+
+			std::vector<escape_t> values;
+			std::vector<bool> known;
+			auto power = View(100);
+			auto julia = View(100);
+			power.new_power(3LL);
+			julia.new_type(mnd::JULIA).new_j_coords(pair_t{ -0.8L, 0.156L });
+
+			Assert::IsTrue(cache.load(View(200), values, known) == 0, L"Other maximum is not covered");
+			Assert::IsTrue(cache.load(power, values, known) == 0, L"Other power is not covered");
+			Assert::IsTrue(cache.load(julia, values, known) == 0, L"Julia set is not covered");
+			Assert::IsTrue(!known[0] && Same(values[0], BOUNDED), L"Uncovered pixels are not known");
+			std::filesystem::remove_all(directory);
+		}
+
+		TEST_METHOD(PannedView)
+		{
+			auto directory = Directory();
+			auto stored = Values();
+			DiskCache cache(directory);
+			cache.store(View(100), stored);
+			cache.flush();
+
+			std::vector<escape_t> values;
+			std::vector<bool> known;
+			auto covered = cache.load(View(100, -2.5L + TO_FLT(PAN) / 16.L), values, known);
+			bool same = true;
+
+			for (int_t y = 0; y < HEIGHT; ++y)
+				for (int_t x = 0; x < WIDTH; ++x)
+					same = same && known[y * WIDTH + x] == (x < WIDTH - PAN)
+						&& (x >= WIDTH - PAN || Same(values[y * WIDTH + x], stored[y * WIDTH + x + PAN]));
+
+			Assert::IsTrue(covered == static_cast<size_t>((WIDTH - PAN) * HEIGHT), L"Overlap of the panned view is covered");
+			Assert::IsTrue(same, L"Panned view takes the cells of the stored one");
+			std::filesystem::remove_all(directory);
+		}
+	};
+}
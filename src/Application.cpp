@@ -23,7 +23,10 @@ Application::Application(font_t& font, int_t width_pixels, int_t height_pixels,
 	_main_overlay(font, _scales, _window),
 	_magnifier(_window),
 	_show_overlay(true),
-	_show_help(false)
+	_show_help(false),
+	_render_finished(false),
+	_render_recorded(false),
+	_control(std::make_shared<Control>())
 {
 	_main_overlay.endnote(DEFAULT_END_NOTE);
 	RebuildGeometry();
@@ -32,7 +35,7 @@ Application::Application(font_t& font, int_t width_pixels, int_t height_pixels,
 }
 
 Application::~Application() {
-	Renderer::Threads::rendering = false;
+	_control->cancel();
 	Threads::Join();
 }
 
@@ -45,7 +48,16 @@ const Geometry2D& Application::scales() const {
 }
 
 const sf::Image& Application::image() const {
-	return _image;
+	return _frames.front();
+}
+
+size_t Application::cache_budget() const {
+	return _results.budget();
+}
+
+Application& Application::cache_budget(size_t bytes) {
+	_results.budget(bytes);
+	return *this;
 }
 
 void Application::Mandelbrot() {
@@ -65,10 +77,15 @@ void Application::PushHistory() {
 
 void Application::PushOverlay() {
 	_main_overlay.state(current_state);
+
+	// Only a finished render has cancelled its token already; a recolored
+	// frame keeps its final count
+	if (!_control->running())
+		_main_overlay.iteration(current_state.max_iterations).remaining(0);
 }
 
 void Application::ChangeState(std::function<void()> action_f) {
-	if (Renderer::Threads::paused)
+	if (_control->paused())
 		TogglePauseRender();
 
 	StopRenderAsync();
@@ -91,6 +108,25 @@ void Application::ChangeOverlayAndHistory(std::function<void()> action_f) {
 	PushHistory();
 }
 
+// A finished render keeps the escape of every pixel, so a new color scheme
+// or algorithm only recolors them; an unfinished one renders again
+void Application::ChangeColorScheme(std::function<void()> action_f) {
+	if (_control->paused())
+		TogglePauseRender();
+
+	StopRenderAsync();
+	action_f();
+
+	if (_render_finished)
+		_frames.recolor(current_state.palette());
+	else
+		StartRenderAsync();
+
+	Application::delay_next_poll = true;
+	PushOverlay();
+	PushHistory();
+}
+
 bool Application::GoToPreviousState() {
 	if (_states.prev()) {
 		current_state = _states.current();
@@ -110,7 +146,7 @@ bool Application::GoToNextState() {
 }
 
 void Application::RebuildGeometry() {
-	*_scales = Geometry2D(current_state.view, current_state.models.top());
+	*_scales = Geometry2D(current_state.geometry());
 }
 
 void Application::RebuildMagnifier() {
@@ -122,11 +158,39 @@ bool Application::PollNext(sf::Event& e) {
 }
 
 void Application::Magnify() {
+	Geometry2D from = *_scales;
+
 	current_state
-		.push_model(_magnifier.get_boundaries(*_scales))
+		.push_model(_magnifier.get_boundaries(current_state.geometry()))
 		.next_magnification();
 
 	RebuildGeometry();
+
+	NewPreview(from);
+}
+
+// Escapes carry over only between views iterated in the same arithmetic;
+// perturbation's depends on the reference, at the center of each view and
+// as long as the maximum, and a recording's on its progressive iteration.
+// When resuming the view is the same, so its stopped orbits go on as well
+void Application::NewPreview(const Geometry2D& from, bool resume) {
+	auto precision = mnd::SelectPrecision(from);
+	bool reusable = _render_finished
+		&& !_render_recorded
+		&& precision == mnd::SelectPrecision(*_scales)
+		&& !(current_state.power == 2LL && (precision == mnd::Precision::DOUBLE_DOUBLE || precision == mnd::Precision::PERTURBATION));
+
+	auto size = _frames.published().getSize();
+
+	if (TO_INT(size.x) != current_state.view.right || TO_INT(size.y) != current_state.view.bottom)
+		return;
+
+	auto preview = std::make_shared<Preview>(_frames.published(), _frames.values(), from, *_scales, reusable);
+
+	if (resume && reusable)
+		preview->resume(_frames.stopped(), _frames.stopped_at());
+
+	_preview = preview;
 }
 
 void Application::Demagnify() {
@@ -138,8 +202,10 @@ void Application::Demagnify() {
 }
 
 void Application::Update() {
-	_texture.loadFromImage(_image);
-	_sprite.setTexture(_texture);
+	// Uploads only the tiles of frames published since the last call
+	if (_frames.upload(_texture))
+		_sprite.setTexture(_texture);
+
 	_main_overlay.update(_window);
 	_magnifier.update(_window);
 }
@@ -162,12 +228,7 @@ void Application::Show() {
 }
 
 pair_t Application::GetCenterCoords() const {
-	auto left = current_state.models.top().left;
-	auto top = current_state.models.top().top;
-	return pair_t{
-		left + abs(left - current_state.models.top().right) / 2,
-		top + abs(top - current_state.models.top().bottom) / 2
-	};
+	return current_state.center();
 }
 
 // Format:
@@ -175,38 +236,7 @@ pair_t Application::GetCenterCoords() const {
 //    yyyy_MM_dd_HHmmss_-_power_magnification_iteration_x_y
 //    
 std::string Application::NewFileName(std::string extension) const {
-	int_t type = current_state.type;
-	int_t iteration = _main_overlay.iteration();
-	int_t power = current_state.power;
-	int_t magnification = current_state.magnification;
-	pair_t j_coords = current_state.j_coords;
-	auto center = GetCenterCoords();
-	std::ostringstream buf;
-
-	buf << type << '_';
-	put_int(buf, power);
-
-	auto fill = buf.fill();
-
-	buf << '_'
-		<< std::hex << magnification << '_'
-		<< std::setfill('0')
-		<< std::setw(std::to_string(current_state.max_iterations).length())
-		<< std::dec << iteration << '_'
-		<< std::setfill(fill);
-
-	put_flt(buf, center.re());
-	buf << '_';
-	put_flt(buf, center.im());
-
-	if (type == mnd::JULIA) {
-		buf << '_';
-		put_flt(buf, j_coords.re());
-		buf << '_';
-		put_flt(buf, j_coords.im());
-	}
-
-	return GetDateTimeString() + "_-_" + buf.str() + extension;
+	return GetDateTimeString() + "_-_" + current_state.file_name(_main_overlay.iteration()) + extension;
 }
 
 bool Application::Save(sf::Sprite& someSprite, const sf::Image& someImage) {
@@ -239,85 +269,35 @@ bool Application::Save(sf::Sprite& someSprite) {
 }
 
 bool Application::Save() {
-	auto temp = Renderer::Threads::paused;
-	Renderer::Threads::paused = true;
+	auto paused = _control->pause();
 	auto success = Save(_sprite);
-	Renderer::Threads::paused = temp;
+	_control->pause(paused);
 	return success;
 }
 
 void Application::GoTo(const std::string& str) {
-	std::stringstream buf(str);
-	std::string temp;
-
-	buf.ignore(std::numeric_limits<std::streamsize>::max(), '-');
-	
-	if (!buf || buf.eof())
-		buf = std::stringstream(str);
-	else
-		buf.ignore(1, '_');
-
-	getline(buf, temp, '_');
-	int_t type = std::stoll(temp);
-
-	getline(buf, temp, '_');
-	int_t power = get_int(temp);
-	
-	getline(buf, temp, '_');
-	int_t magnification = std::stoll(temp);
-
-	getline(buf, temp, '_');
-	int_t iteration = std::stoll(temp);
-
-	getline(buf, temp, '_');
-	flt_t coord_x = get_flt(temp);
-
-	getline(buf, temp, type == mnd::JULIA ? '_' : '.');
-	flt_t coord_y = get_flt(temp);
-
-	current_state
-		.new_type(type)
-		.new_power(power)
-		.init_magnification()
-		.init_max_iterations();
-
-	if (type == mnd::JULIA) {
-		getline(buf, temp, '_');
-		flt_t j_coord_x = get_flt(temp);
-
-		getline(buf, temp, '.');
-		flt_t j_coord_y = get_flt(temp);
-
-		current_state
-			.new_j_coords(pair_t{ j_coord_x, j_coord_y });
-	}
-
+	current_state.go_to(str, TrackingBox::factor);
 	RebuildGeometry();
+	_main_overlay.state(current_state);
+}
 
-	while (magnification < current_state.magnification) {
-		_magnifier.move(
-			_scales->horz().to_pixel(coord_x),
-			_scales->vert().to_pixel(coord_y)
-		);
-		Demagnify();
-	}
-
-	while (magnification > current_state.magnification) {
-		_magnifier.move(
-			_scales->horz().to_pixel(coord_x),
-			_scales->vert().to_pixel(coord_y)
-		);
-		Magnify();
-	}
+// Pixels that escaped under the old maximum escape alike under a higher
+// one, so a finished render passes them on as known, and the orbits it
+// stopped at the old maximum go on from there
+void Application::ChangeMaximum(int_t max) {
+	ChangeOverlayAndHistory([&]() {
+		bool raised = max > current_state.max_iterations;
+		current_state.new_max_iterations(max);
 
-	_main_overlay.state(current_state);
+		if (raised)
+			NewPreview(*_scales, true);
+	});
 }
 
 bool Application::EnterNewMaximum(int_t& max) {
 	bool maximumChanged = false;
 	bool acceptingInput = true;
-	bool prevState = Renderer::Threads::paused;
-	Renderer::Threads::paused = true;
+	bool prevState = _control->pause();
 
 	InputBox inputOverlay(_font);
 	std::string promptMsg = "Enter new maximum: ";
@@ -412,15 +392,14 @@ bool Application::EnterNewMaximum(int_t& max) {
 	if (maximumChanged)
 		max = std::stoll(info.str);
 
-	Renderer::Threads::paused = prevState;
+	_control->pause(prevState);
 	return maximumChanged;
 }
 
 bool Application::EnterNewCoordinates(pair_t& coords) {
 	bool acceptingInput = true;
 	bool actionConfirmed = false;
-	bool prevState = Renderer::Threads::paused;
-	Renderer::Threads::paused = true;
+	bool prevState = _control->pause();
 
 	InputBox inputOverlay(_font);
 	inputOverlay.set(
@@ -471,17 +450,70 @@ bool Application::EnterNewCoordinates(pair_t& coords) {
 		Show();
 	}
 
-	Renderer::Threads::paused = prevState;
+	_control->pause(prevState);
 	return actionConfirmed;
 }
 
+// Each render gets its own token, paused if the last one was
+control_ptr Application::NewControl() {
+	auto control = std::make_shared<Control>();
+	control->pause(_control->paused());
+	_control = control;
+	return control;
+}
+
 void Application::StartRenderAsync() {
+	_rendered_state = current_state;
+	_render_recorded = false;
+
+	// A view rendered before, in this session or an earlier one, shows at
+	// once, finished; one the disk covers in part starts from what it has
+	auto values = _results.find(current_state);
+	std::vector<escape_t> loaded;
+	std::vector<bool> known;
+
+	if (values == nullptr) {
+		auto covered = _disk.load(current_state, loaded, known);
+
+		if (covered == loaded.size()) {
+			_results.add(current_state, loaded);
+			values = &loaded;
+		}
+		else if (covered > 0) {
+			auto preview = _preview
+				? std::make_shared<Preview>(*_preview)
+				: std::make_shared<Preview>(current_state.view.right, current_state.view.bottom);
+
+			preview->know(loaded, known, current_state.palette());
+			_preview = preview;
+		}
+	}
+
+	if (values != nullptr) {
+		_frames.create(
+			current_state.view.right,
+			current_state.view.bottom,
+			*values,
+			current_state.palette()
+		);
+
+		// A cancelled token marks the frame finished for PushOverlay
+		_preview.reset();
+		NewControl()->cancel();
+		return;
+	}
+
 	_main_overlay.rendering_msg("Rendering...");
-	_image.create(current_state.view.right, current_state.view.bottom, mnd::INIT_COLOR);
+
+	if (_preview)
+		_frames.create(_preview->image(), _preview->values());
+	else
+		_frames.create(current_state.view.right, current_state.view.bottom, mnd::INIT_COLOR);
+
 	_render_thread = std::thread(
-		[i = std::ref(_image), o = std::ref(_main_overlay), s = current_state]() {
-			Renderer r(i, o, s);
-			r.Run();
+		[f = std::ref(_frames), o = std::ref(_main_overlay), s = current_state, c = NewControl(), p = std::move(_preview)]() {
+			Renderer r(f, o, s);
+			r.mode(RenderMode::COARSE_TO_FINE).subdivide(true).control(c).preview(p).Run();
 			o.get().rendering_msg("");
 		}
 	);
@@ -489,17 +521,19 @@ void Application::StartRenderAsync() {
 
 void Application::StartRecordingRenderAsync() {
 	_main_overlay.rendering_msg("Recording...");
-	_image.create(current_state.view.right, current_state.view.bottom, mnd::INIT_COLOR);
+	_rendered_state = current_state;
+	_render_recorded = true;
+	_frames.create(current_state.view.right, current_state.view.bottom, mnd::INIT_COLOR);
 	_render_thread = std::thread(
-		[&, i = std::ref(_image), o = std::ref(_main_overlay), s = current_state]() {
-			Renderer r(i, o, s);
+		[&, f = std::ref(_frames), o = std::ref(_main_overlay), s = current_state, c = NewControl()]() {
+			Renderer r(f, o, s);
 
 			sf::Sprite someSprite;
-			auto someImage = r.Start();
+			r.control(c).Start();
 
 			while (r.HasNext()) {
-				r.Next(someImage);
-				Save(someSprite, i.get());
+				r.Next();
+				Save(someSprite, f.get().published());
 			}
 
 			r.Close();
@@ -509,11 +543,16 @@ void Application::StartRecordingRenderAsync() {
 }
 
 void Application::StopRenderAsync() {
-	Renderer::Threads::rendering = false;
+	// Only the render itself cancels its token before this
+	_render_finished = !_control->running();
+	_control->cancel();
 	_main_overlay.rendering_msg("");
 
 	if (_render_thread.joinable())
 		_render_thread.join();
+
+	if (_render_finished && !_render_recorded && _results.add(_rendered_state, _frames.values()))
+		_disk.store(_rendered_state, _frames.values());
 }
 
 void Application::StartTimedMessageAsync(const std::string& message, int_t seconds) {
@@ -550,10 +589,15 @@ bool Application::ToggleOverlay() {
 	return _show_overlay;
 }
 
+bool Application::IsPaused() const {
+	return _control->paused();
+}
+
 bool Application::TogglePauseRender() {
-	Renderer::Threads::paused = !Renderer::Threads::paused;
+	auto paused = !_control->paused();
+	_control->pause(paused);
 
-	if (Renderer::Threads::paused) {
+	if (paused) {
 		Application::notifying = false;
 		_main_overlay.notification("Paused.");
 	}
@@ -561,7 +605,7 @@ bool Application::TogglePauseRender() {
 		StartTimedMessageAsync("Unpaused.");
 	}
 
-	return Renderer::Threads::paused;
+	return paused;
 }
 
 bool Application::ToggleHelpMessage(const char* msg) {
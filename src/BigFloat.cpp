@@ -0,0 +1,337 @@
+#include "BigFloat.h"
+#include <algorithm>
+#include <assert.h>
+#include <climits>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+	// Limb i of m shifted right by shift bits, zero outside of m
+	uint32_t ShiftedLimb(const std::vector<uint32_t>& m, int_t shift, int_t i) {
+		int_t j = i - shift / TO_INT(LIMB_BITS);
+		int_t r = shift % TO_INT(LIMB_BITS);
+		int_t n = TO_INT(m.size());
+
+		uint64_t high = j >= 0 && j < n ? m[j] : 0;
+		uint64_t low = r > 0 && j >= 1 && j - 1 < n ? m[j - 1] : 0;
+
+		return static_cast<uint32_t>((high >> r) | (low << (LIMB_BITS - r)));
+	}
+};
+
+BigFloat::BigFloat() :
+	BigFloat(0.L, MIN_LIMBS) {}
+
+BigFloat::BigFloat(int value) :
+	BigFloat(TO_FLT(value), MIN_LIMBS) {}
+
+BigFloat::BigFloat(double value) :
+	BigFloat(TO_FLT(value), MIN_LIMBS) {}
+
+BigFloat::BigFloat(long double value) :
+	BigFloat(value, MIN_LIMBS) {}
+
+BigFloat::BigFloat(long double value, size_t limbs) :
+	_negative(value < 0),
+	_exponent(0),
+	_mantissa(std::max(limbs, MIN_LIMBS), 0)
+{
+	assert(std::isfinite(value));
+
+	int exponent = 0;
+	auto m = std::frexp(std::fabs(value), &exponent);
+	_exponent = exponent;
+
+	for (auto& limb : _mantissa) {
+		m = std::ldexp(m, TO_INT(LIMB_BITS));
+		limb = static_cast<uint32_t>(m);
+		m -= limb;
+	}
+
+	normalize();
+}
+
+BigFloat& BigFloat::normalize() {
+	size_t n = _mantissa.size();
+	size_t zeros = 0;
+
+	while (zeros < n && _mantissa[zeros] == 0)
+		++zeros;
+
+	if (zeros == n) {
+		_negative = false;
+		_exponent = 0;
+		return *this;
+	}
+
+	int_t shift = TO_INT(zeros * LIMB_BITS);
+
+	for (auto top = _mantissa[zeros]; (top & 0x80000000u) == 0; top <<= 1)
+		++shift;
+
+	if (shift > 0) {
+		size_t q = shift / LIMB_BITS;
+		size_t r = shift % LIMB_BITS;
+
+		for (size_t i = 0; i < n; ++i) {
+			uint32_t high = i + q < n ? _mantissa[i + q] : 0;
+			uint32_t low = r > 0 && i + q + 1 < n ? _mantissa[i + q + 1] : 0;
+			_mantissa[i] = r > 0 ? (high << r) | (low >> (LIMB_BITS - r)) : high;
+		}
+
+		_exponent -= shift;
+	}
+
+	return *this;
+}
+
+/*
+	Horner from the least significant limb, three being more than any
+	float type holds
+
+		x = ((m_2 2^-32 + m_1) 2^-32 + m_0) 2^-32 2^exponent
+*/
+template <typename T>
+T BigFloat::to_float() const {
+	if (zero())
+		return T(0);
+
+	T value = 0;
+
+	for (size_t i = std::min<size_t>(3, _mantissa.size()); i-- > 0;)
+		value = (value + T(_mantissa[i])) * T(1.0 / 4294967296.0);
+
+	int exponent =
+		_exponent < INT_MIN ? INT_MIN
+		: _exponent > INT_MAX ? INT_MAX
+		: static_cast<int>(_exponent);
+
+	value = std::ldexp(value, exponent);
+	return _negative ? -value : value;
+}
+
+BigFloat::operator float() const { return to_float<float>(); }
+BigFloat::operator double() const { return to_float<double>(); }
+BigFloat::operator long double() const { return to_float<long double>(); }
+
+BigFloat::operator dd_t() const {
+	double hi = to_float<double>();
+	return dd_t(hi, (*this - BigFloat(hi)).to_float<double>());
+}
+
+size_t BigFloat::limbs() const {
+	return _mantissa.size();
+}
+
+BigFloat& BigFloat::limbs(size_t count) {
+	_mantissa.resize(std::max(count, MIN_LIMBS), 0);
+	return normalize();
+}
+
+bool BigFloat::negative() const {
+	return _negative;
+}
+
+bool BigFloat::zero() const {
+	return _mantissa[0] == 0;
+}
+
+std::string BigFloat::hex() const {
+	std::ostringstream buf;
+	buf << (_negative ? 'n' : 'p') << std::hex << _exponent;
+
+	for (auto limb : _mantissa)
+		buf << '_' << std::setw(8) << std::setfill('0') << limb;
+
+	return buf.str();
+}
+
+size_t BigFloat::LimbsForSpacing(flt_t spacing) {
+	if (!(spacing > 0) || !std::isfinite(spacing))
+		return MIN_LIMBS;
+
+	int_t bits = COORD_BITS - std::ilogb(spacing) + GUARD_BITS;
+	auto limbs = static_cast<size_t>((bits + TO_INT(LIMB_BITS) - 1) / TO_INT(LIMB_BITS));
+	return std::max(MIN_LIMBS, limbs);
+}
+
+int BigFloat::CompareMagnitudes(const BigFloat& a, const BigFloat& b) {
+	if (a.zero() || b.zero())
+		return a.zero() ? (b.zero() ? 0 : -1) : 1;
+
+	if (a._exponent != b._exponent)
+		return a._exponent < b._exponent ? -1 : 1;
+
+	size_t n = std::max(a.limbs(), b.limbs());
+
+	for (size_t i = 0; i < n; ++i) {
+		uint32_t x = i < a.limbs() ? a._mantissa[i] : 0;
+		uint32_t y = i < b.limbs() ? b._mantissa[i] : 0;
+
+		if (x != y)
+			return x < y ? -1 : 1;
+	}
+
+	return 0;
+}
+
+/*
+	b is aligned to a's exponent and summed over the longer operand's
+	limbs and one guard limb; a carry out of the top limb shifts the sum
+	right by one bit
+
+	Requires |a| >= |b|
+*/
+BigFloat BigFloat::AddMagnitudes(const BigFloat& a, const BigFloat& b) {
+	size_t n = std::max(a.limbs(), b.limbs());
+	int_t shift = a._exponent - b._exponent;
+	std::vector<uint32_t> sum(n + 1);
+	uint64_t carry = 0;
+
+	for (size_t i = n + 1; i-- > 0;) {
+		uint64_t x = i < a.limbs() ? a._mantissa[i] : 0;
+		carry += x + ShiftedLimb(b._mantissa, shift, TO_INT(i));
+		sum[i] = static_cast<uint32_t>(carry);
+		carry >>= LIMB_BITS;
+	}
+
+	BigFloat result;
+	result._negative = a._negative;
+	result._exponent = a._exponent;
+
+	if (carry) {
+		for (size_t i = n + 1; i-- > 1;)
+			sum[i] = (sum[i] >> 1) | (sum[i - 1] << (LIMB_BITS - 1));
+
+		sum[0] = (sum[0] >> 1) | 0x80000000u;
+		++result._exponent;
+	}
+
+	sum.resize(n);
+	result._mantissa = std::move(sum);
+	return result;
+}
+
+/*
+	As AddMagnitudes, borrowing instead of carrying; the leading zeros left
+	by cancellation are shifted out by normalize()
+
+	Requires |a| >= |b|
+*/
+BigFloat BigFloat::SubtractMagnitudes(const BigFloat& a, const BigFloat& b) {
+	size_t n = std::max(a.limbs(), b.limbs());
+	int_t shift = a._exponent - b._exponent;
+	std::vector<uint32_t> difference(n + 1);
+	int64_t borrow = 0;
+
+	for (size_t i = n + 1; i-- > 0;) {
+		int64_t x = i < a.limbs() ? a._mantissa[i] : 0;
+		int64_t d = x - ShiftedLimb(b._mantissa, shift, TO_INT(i)) - borrow;
+		borrow = d < 0 ? 1 : 0;
+		difference[i] = static_cast<uint32_t>(d + (borrow << LIMB_BITS));
+	}
+
+	BigFloat result;
+	result._negative = a._negative;
+	result._exponent = a._exponent;
+	result._mantissa = std::move(difference);
+	result.normalize();
+	result._mantissa.resize(n);
+	return result;
+}
+
+const BigFloat operator-(const BigFloat& a) {
+	BigFloat result = a;
+
+	if (!result.zero())
+		result._negative = !result._negative;
+
+	return result;
+}
+
+const BigFloat operator+(const BigFloat& a, const BigFloat& b) {
+	if (b.zero())
+		return BigFloat(a).limbs(std::max(a.limbs(), b.limbs()));
+
+	if (a.zero())
+		return BigFloat(b).limbs(std::max(a.limbs(), b.limbs()));
+
+	int order = BigFloat::CompareMagnitudes(a, b);
+	const BigFloat& larger = order >= 0 ? a : b;
+	const BigFloat& smaller = order >= 0 ? b : a;
+
+	if (a._negative == b._negative)
+		return BigFloat::AddMagnitudes(larger, smaller);
+
+	if (order == 0)
+		return BigFloat(0.L, std::max(a.limbs(), b.limbs()));
+
+	return BigFloat::SubtractMagnitudes(larger, smaller);
+}
+
+/*
+	Limb products a_i b_j weigh 2^-32(i + j + 2), landing in columns i + j
+	(high half) and i + j + 1 (low half). Columns past the guard limb n are
+	dropped, which costs under n ulps of the guard limb:
+
+		0.a_0 a_1 ... * 0.b_0 b_1 ... = 0.r_0 r_1 ... r_n (+ dropped)
+
+	The product of two significands in [1/2, 1) lies in [1/4, 1), so at
+	most one bit of normalization follows
+*/
+const BigFloat operator*(const BigFloat& a, const BigFloat& b) {
+	size_t n = std::max(a.limbs(), b.limbs());
+
+	if (a.zero() || b.zero())
+		return BigFloat(0.L, n);
+
+	std::vector<uint64_t> columns(n + 2, 0);
+
+	for (size_t i = 0; i < a.limbs() && i <= n; ++i) {
+		uint64_t x = a._mantissa[i];
+
+		if (x == 0)
+			continue;
+
+		for (size_t j = 0; j < b.limbs() && i + j <= n; ++j) {
+			uint64_t p = x * b._mantissa[j];
+			columns[i + j] += p >> LIMB_BITS;
+			columns[i + j + 1] += p & 0xffffffffu;
+		}
+	}
+
+	BigFloat result;
+	result._negative = a._negative != b._negative;
+	result._exponent = a._exponent + b._exponent;
+	result._mantissa.assign(n + 1, 0);
+
+	uint64_t carry = columns[n + 1] >> LIMB_BITS;
+
+	for (size_t i = n + 1; i-- > 0;) {
+		carry += columns[i];
+		result._mantissa[i] = static_cast<uint32_t>(carry);
+		carry >>= LIMB_BITS;
+	}
+
+	result.normalize();
+	result._mantissa.resize(n);
+	return result;
+}
+
+bool operator<(const BigFloat& a, const BigFloat& b) {
+	if (a._negative != b._negative)
+		return a._negative;
+
+	int order = BigFloat::CompareMagnitudes(a, b);
+	return a._negative ? order > 0 : order < 0;
+}
+
+bool operator==(const BigFloat& a, const BigFloat& b) {
+	return a._negative == b._negative && BigFloat::CompareMagnitudes(a, b) == 0;
+}
+
+std::ostream& operator<<(std::ostream& out, const BigFloat& a) {
+	return out << static_cast<long double>(a);
+}
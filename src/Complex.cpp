@@ -282,10 +282,6 @@ pair_t fpow(const pair_t& z, flt_t c) {
 	return TO_FLT(pow(abs(z), c)) * cis(c * arg(z));
 }
 
-flt_t sq_sum(const pair_t& z) {
-	return z.re() * z.re() + z.im() * z.im();
-}
-
 pair_t sqrt(const pair_t& z) {
 	return fpow(z, 0.5L);
 }
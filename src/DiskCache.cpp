@@ -0,0 +1,457 @@
+#include "DiskCache.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	const char MAGIC[] = { 'M', 'N', 'T', '1' };
+	const size_t CELLS = static_cast<size_t>(TILE_CELLS * TILE_CELLS);
+
+	// A cell no view has written to
+	const escape_t EMPTY{ -3LL, 0. };
+
+	// Ahead of the key, padded to whole cells, then the cells row by row
+	struct Header {
+		char magic[4];
+		uint32_t key_size;
+		int64_t level;
+		int64_t tile_x;
+		int64_t tile_y;
+	};
+
+	size_t CellsOffset(size_t key_size) {
+		auto offset = sizeof(Header) + key_size;
+		return (offset + sizeof(escape_t) - 1) / sizeof(escape_t) * sizeof(escape_t);
+	}
+
+	// The fields of a State its escapes depend on besides the view, exactly
+	std::string Key(const State& state) {
+		std::ostringstream buf;
+
+		for (auto value : { state.type, state.power, state.threshold, state.max_iterations }) {
+			put_int(buf, value);
+			buf << '_';
+		}
+
+		auto j_coords = state.type == mnd::JULIA ? state.j_coords : INIT_PAIR;
+
+		// Hex floats are exact, and skip the padding bytes of long double
+		buf << std::hexfloat << j_coords.re() << '_' << j_coords.im();
+		return buf.str();
+	}
+
+	// The level whose cells are the widest no wider than a pixel
+	int_t Level(const Geometry2D& scales) {
+		return -static_cast<int_t>(std::ilogb(mnd::PixelSpacing(scales)));
+	}
+
+	int_t Cell(flt_t coord, int_t level) {
+		return static_cast<int_t>(std::floor(std::ldexp(coord, static_cast<int>(level))));
+	}
+
+	int_t Tile(int_t cell) {
+		return cell >= 0 ? cell / TILE_CELLS : (cell - TILE_CELLS + 1) / TILE_CELLS;
+	}
+
+	size_t Offset(int_t cell) {
+		return static_cast<size_t>(cell - Tile(cell) * TILE_CELLS);
+	}
+
+	// Pixels [first, last) of a row or column, whose cells are in one tile
+	struct Run {
+		int_t tile;
+		int_t first;
+		int_t last;
+	};
+
+	// Cells follow the pixels in order, so each tile's pixels are adjacent
+	std::vector<Run> Runs(const std::vector<int_t>& cells) {
+		std::vector<Run> runs;
+
+		for (int_t pixel = 0; pixel < static_cast<int_t>(cells.size()); ++pixel) {
+			auto tile = Tile(cells[pixel]);
+
+			if (runs.empty() || runs.back().tile != tile)
+				runs.push_back(Run{ tile, pixel, pixel });
+
+			runs.back().last = pixel + 1;
+		}
+
+		return runs;
+	}
+
+	std::vector<int_t> Columns(const Geometry2D& scales, int_t level) {
+		std::vector<int_t> cells(static_cast<size_t>(scales.horz().max_pixel()));
+
+		for (size_t x = 0; x < cells.size(); ++x)
+			cells[x] = Cell(scales.coord_x(static_cast<int_t>(x)), level);
+
+		return cells;
+	}
+
+	std::vector<int_t> Rows(const Geometry2D& scales, int_t level) {
+		std::vector<int_t> cells(static_cast<size_t>(scales.vert().max_pixel()));
+
+		for (size_t y = 0; y < cells.size(); ++y)
+			cells[y] = Cell(scales.coord_y(static_cast<int_t>(y)), level);
+
+		return cells;
+	}
+
+	// A whole file mapped read-only, unmapped with it; data() is null when
+	// the file could not be opened or is empty
+	class MappedFile {
+	private:
+		const char* _data;
+		size_t _size;
+#ifdef _WIN32
+		HANDLE _file;
+		HANDLE _mapping;
+#else
+		int _file;
+#endif
+	public:
+		MappedFile(const std::string& path);
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		~MappedFile();
+
+		const char* data() const { return _data; }
+		size_t size() const { return _size; }
+	};
+
+#ifdef _WIN32
+	MappedFile::MappedFile(const std::string& path) :
+		_data(nullptr),
+		_size(0),
+		_mapping(nullptr)
+	{
+		_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+		LARGE_INTEGER size;
+
+		if (_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(_file, &size) || size.QuadPart == 0)
+			return;
+
+		_mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		if (_mapping == nullptr)
+			return;
+
+		_data = static_cast<const char*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+		_size = _data != nullptr ? static_cast<size_t>(size.QuadPart) : 0;
+	}
+
+	MappedFile::~MappedFile() {
+		if (_data != nullptr)
+			UnmapViewOfFile(_data);
+
+		if (_mapping != nullptr)
+			CloseHandle(_mapping);
+
+		if (_file != INVALID_HANDLE_VALUE)
+			CloseHandle(_file);
+	}
+
+	std::string Environment(const char* name) {
+		char value[MAX_PATH];
+		auto size = GetEnvironmentVariableA(name, value, MAX_PATH);
+		return size > 0 && size < MAX_PATH ? std::string(value, size) : std::string();
+	}
+#else
+	MappedFile::MappedFile(const std::string& path) :
+		_data(nullptr),
+		_size(0)
+	{
+		_file = open(path.c_str(), O_RDONLY);
+
+		struct stat info;
+
+		if (_file < 0 || fstat(_file, &info) != 0 || info.st_size == 0)
+			return;
+
+		auto data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, _file, 0);
+
+		if (data == MAP_FAILED)
+			return;
+
+		_data = static_cast<const char*>(data);
+		_size = static_cast<size_t>(info.st_size);
+	}
+
+	MappedFile::~MappedFile() {
+		if (_data != nullptr)
+			munmap(const_cast<char*>(_data), _size);
+
+		if (_file >= 0)
+			close(_file);
+	}
+
+	std::string Environment(const char* name) {
+		auto value = std::getenv(name);
+		return value != nullptr ? std::string(value) : std::string();
+	}
+#endif
+
+	// So a relative directory stays where it was when the cache was made
+	std::string Absolute(const std::string& directory) {
+		std::error_code error;
+		auto absolute = fs::absolute(directory, error);
+		return error ? directory : absolute.string();
+	}
+
+	// The cells of a tile file, null unless it is whole and its header is
+	// the one asked for
+	const escape_t* Cells(const MappedFile& file, const std::string& key, int_t level, int_t tile_x, int_t tile_y) {
+		if (file.data() == nullptr || file.size() < sizeof(Header))
+			return nullptr;
+
+		Header header;
+		std::memcpy(&header, file.data(), sizeof(Header));
+
+		auto offset = CellsOffset(header.key_size);
+
+		if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0
+			|| header.key_size != key.size()
+			|| header.level != level
+			|| header.tile_x != tile_x
+			|| header.tile_y != tile_y
+			|| file.size() < offset + CELLS * sizeof(escape_t)
+			|| key.compare(0, key.size(), file.data() + sizeof(Header), header.key_size) != 0)
+			return nullptr;
+
+		return reinterpret_cast<const escape_t*>(file.data() + offset);
+	}
+};
+
+std::string DefaultCacheDirectory() {
+#ifdef _WIN32
+	auto base = Environment("LOCALAPPDATA");
+
+	if (!base.empty())
+		return (fs::path(base) / "mandelbrot" / "cache").string();
+#else
+	auto base = Environment("XDG_CACHE_HOME");
+
+	if (!base.empty())
+		return (fs::path(base) / "mandelbrot").string();
+
+	base = Environment("HOME");
+
+	if (!base.empty())
+		return (fs::path(base) / ".cache" / "mandelbrot").string();
+#endif
+
+	std::error_code error;
+	return (fs::temp_directory_path(error) / "mandelbrot-cache").string();
+}
+
+DiskCache::DiskCache(const std::string& directory, size_t tiles) :
+	_directory(Absolute(directory)),
+	_tiles(tiles == 0 ? 1 : tiles),
+	_writing(false),
+	_stopping(false),
+	_writer(&DiskCache::Work, this) {}
+
+DiskCache::~DiskCache() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stopping = true;
+	}
+
+	_queued.notify_all();
+
+	if (_writer.joinable())
+		_writer.join();
+}
+
+std::string DiskCache::path(const std::string& key, int_t level, int_t tile_x, int_t tile_y) const {
+	auto name = std::to_string(tile_x) + "_" + std::to_string(tile_y) + ".tile";
+	return (fs::path(_directory) / key / std::to_string(level) / name).string();
+}
+
+size_t DiskCache::load(const State& state, std::vector<escape_t>& values, std::vector<bool>& known) const {
+	auto scales = Geometry2D(state.geometry());
+	auto width = static_cast<size_t>(scales.horz().max_pixel());
+	auto level = Level(scales);
+
+	values.assign(width * static_cast<size_t>(scales.vert().max_pixel()), BOUNDED);
+	known.assign(values.size(), false);
+
+	if (level > MAX_TILE_LEVEL)
+		return 0;
+
+	auto key = Key(state);
+	auto columns = Columns(scales, level);
+	auto rows = Rows(scales, level);
+	size_t covered = 0;
+
+	for (const auto& row : Runs(rows)) {
+		for (const auto& column : Runs(columns)) {
+			MappedFile file(path(key, level, column.tile, row.tile));
+			auto cells = Cells(file, key, level, column.tile, row.tile);
+
+			if (cells == nullptr)
+				continue;
+
+			for (auto y = row.first; y < row.last; ++y) {
+				auto line = cells + Offset(rows[y]) * TILE_CELLS;
+
+				for (auto x = column.first; x < column.last; ++x) {
+					const auto& cell = line[Offset(columns[x])];
+
+					if (cell.iteration == EMPTY.iteration)
+						continue;
+
+					values[y * width + x] = cell;
+					known[y * width + x] = true;
+					++covered;
+				}
+			}
+		}
+	}
+
+	return covered;
+}
+
+void DiskCache::store(const State& state, const std::vector<escape_t>& values) {
+	auto scales = Geometry2D(state.geometry());
+	auto level = Level(scales);
+
+	if (level > MAX_TILE_LEVEL)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_jobs.push_back(Job{ Key(state), level, scales, values });
+	}
+
+	_queued.notify_one();
+}
+
+void DiskCache::flush() {
+	std::unique_lock<std::mutex> lock(_mutex);
+	_written.wait(lock, [this]() { return _jobs.empty() && !_writing; });
+}
+
+// Until stopped with nothing left to write
+void DiskCache::Work() {
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	while (true) {
+		_queued.wait(lock, [this]() { return _stopping || !_jobs.empty(); });
+
+		if (_jobs.empty())
+			return;
+
+		auto job = std::move(_jobs.front());
+		_jobs.pop_front();
+		_writing = true;
+		lock.unlock();
+
+		Write(job);
+		Trim();
+
+		lock.lock();
+		_writing = false;
+		_written.notify_all();
+	}
+}
+
+// Each tile the view covers is merged with what is on disk, written aside
+// and renamed over the old file, so a reader never maps half of one
+void DiskCache::Write(const Job& job) {
+	auto width = static_cast<size_t>(job.scales.horz().max_pixel());
+	auto columns = Columns(job.scales, job.level);
+	auto rows = Rows(job.scales, job.level);
+
+	Header header;
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.key_size = static_cast<uint32_t>(job.key.size());
+	header.level = job.level;
+
+	std::vector<escape_t> cells(CELLS);
+	std::vector<char> padding(CellsOffset(job.key.size()) - sizeof(Header) - job.key.size(), 0);
+	std::error_code error;
+
+	for (const auto& row : Runs(rows)) {
+		for (const auto& column : Runs(columns)) {
+			auto target = path(job.key, job.level, column.tile, row.tile);
+			auto temp = target + ".tmp";
+
+			{
+				MappedFile file(target);
+				auto old = Cells(file, job.key, job.level, column.tile, row.tile);
+
+				if (old != nullptr)
+					std::copy(old, old + CELLS, cells.begin());
+				else
+					std::fill(cells.begin(), cells.end(), EMPTY);
+			}
+
+			for (auto y = row.first; y < row.last; ++y) {
+				auto line = cells.begin() + Offset(rows[y]) * TILE_CELLS;
+
+				for (auto x = column.first; x < column.last; ++x)
+					line[Offset(columns[x])] = job.values[y * width + x];
+			}
+
+			header.tile_x = column.tile;
+			header.tile_y = row.tile;
+			fs::create_directories(fs::path(target).parent_path(), error);
+
+			bool written;
+
+			{
+				std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+
+				out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+				out.write(job.key.data(), job.key.size());
+				out.write(padding.data(), padding.size());
+				out.write(reinterpret_cast<const char*>(cells.data()), cells.size() * sizeof(escape_t));
+				written = static_cast<bool>(out);
+			}
+
+			if (written)
+				fs::rename(temp, target, error);
+			else
+				fs::remove(temp, error);
+		}
+	}
+}
+
+// Drops the least recently written tiles past the budget
+void DiskCache::Trim() {
+	std::vector<std::pair<fs::file_time_type, fs::path>> tiles;
+	std::error_code error;
+
+	for (fs::recursive_directory_iterator it(_directory, error), end; !error && it != end; it.increment(error))
+		if (it->path().extension() == ".tile")
+			tiles.push_back({ it->last_write_time(error), it->path() });
+
+	if (tiles.size() <= _tiles)
+		return;
+
+	std::sort(tiles.begin(), tiles.end());
+
+	for (size_t i = 0; i < tiles.size() - _tiles; ++i)
+		fs::remove(tiles[i].second, error);
+}
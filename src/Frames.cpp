@@ -0,0 +1,222 @@
+#include "Frames.h"
+#include <algorithm>
+#include <utility>
+
+FrameBuffer::FrameBuffer() :
+	_versions{ 0, 0, 0 },
+	_middle(1),
+	_stopped_at(0),
+	_back(0),
+	_published(1),
+	_stale(false),
+	_version(1),
+	_front(2),
+	_uploaded(-1) {}
+
+void FrameBuffer::create(unsigned width, unsigned height, const sf::Color& color) {
+	for (auto& image : _images)
+		image.create(width, height, color);
+
+	_values.assign(static_cast<size_t>(width) * height, BOUNDED);
+	reset();
+}
+
+void FrameBuffer::create(const sf::Image& image, const std::vector<escape_t>& values) {
+	for (auto& copy : _images)
+		copy = image;
+
+	_values = values;
+	reset();
+}
+
+// Colored into the first frame, already published
+void FrameBuffer::create(unsigned width, unsigned height, const std::vector<escape_t>& values, const Palette& palette) {
+	create(width, height, mnd::INIT_COLOR);
+	_values = values;
+	recolor(palette);
+}
+
+void FrameBuffer::reset() {
+	for (auto& version : _versions)
+		version = 0;
+
+	_middle = 1;
+	_back = 0;
+	_published = 1;
+	_stale = false;
+	_version = 1;
+	_front = 2;
+	_uploaded = -1;
+	_touched.assign(_tiles.size(), 0);
+	_stopped.clear();
+	_stopped_at = 0;
+}
+
+void FrameBuffer::layout(const TileScheduler& tiles) {
+	_tiles.clear();
+
+	for (size_t t = 0; t < tiles.size(); ++t)
+		_tiles.push_back(tiles.tile(t));
+
+	_touched.assign(_tiles.size(), _version - 1);
+}
+
+sf::Image& FrameBuffer::back() {
+	if (_stale) {
+		auto& image = _images[_back];
+
+		for (size_t t = 0; t < _tiles.size(); ++t) {
+			if (_touched[t] <= _versions[_back])
+				continue;
+
+			const auto& tile = _tiles[t];
+
+			image.copy(
+				_images[_published],
+				static_cast<unsigned>(tile.left),
+				static_cast<unsigned>(tile.top),
+				sf::IntRect(
+					static_cast<int>(tile.left),
+					static_cast<int>(tile.top),
+					static_cast<int>(tile.right - tile.left),
+					static_cast<int>(tile.bottom - tile.top)
+				)
+			);
+		}
+
+		_versions[_back] = _version - 1;
+		_stale = false;
+	}
+
+	return _images[_back];
+}
+
+void FrameBuffer::touch(size_t tile) {
+	_touched[tile] = _version;
+}
+
+void FrameBuffer::touch_all() {
+	_touched.assign(_tiles.size(), _version);
+}
+
+void FrameBuffer::publish() {
+	_tile_versions[_back] = _touched;
+	_versions[_back] = _version++;
+	_published = _back;
+	_back = _middle.exchange(_back | FRESH) & ~FRESH;
+	_stale = true;
+}
+
+const sf::Image& FrameBuffer::published() const {
+	return _images[_published];
+}
+
+const std::vector<escape_t>& FrameBuffer::values() const {
+	return _values;
+}
+
+const escape_t& FrameBuffer::value(int_t x, int_t y) const {
+	return _values[y * _images[_back].getSize().x + x];
+}
+
+void FrameBuffer::value(int_t x, int_t y, const escape_t& value) {
+	_values[y * _images[_back].getSize().x + x] = value;
+}
+
+const std::vector<stopped_t>& FrameBuffer::stopped() const {
+	return _stopped;
+}
+
+int_t FrameBuffer::stopped_at() const {
+	return _stopped_at;
+}
+
+void FrameBuffer::stopped(std::vector<stopped_t> orbits, int_t iteration) {
+	_stopped = std::move(orbits);
+	_stopped_at = iteration;
+}
+
+void FrameBuffer::recolor(const Palette& palette) {
+	auto& image = back();
+	auto size = image.getSize();
+
+	for (unsigned y = 0; y < size.y; ++y)
+		for (unsigned x = 0; x < size.x; ++x)
+			image.setPixel(x, y, palette.color(_values[y * size.x + x]));
+
+	touch_all();
+	publish();
+}
+
+bool FrameBuffer::acquire() {
+	if ((_middle.load() & FRESH) == 0)
+		return false;
+
+	_front = _middle.exchange(_front) & ~FRESH;
+	return true;
+}
+
+const sf::Image& FrameBuffer::front() const {
+	return _images[_front];
+}
+
+bool FrameBuffer::upload(sf::Texture& texture) {
+	if (!acquire())
+		return false;
+
+	const auto& image = front();
+	const auto& changed = _tile_versions[_front];
+
+	if (_uploaded < 0 || texture.getSize() != image.getSize() || changed.size() != _tiles.size()) {
+		texture.loadFromImage(image);
+		_uploaded = _versions[_front];
+		return true;
+	}
+
+	// Runs of changed tiles along a row of tiles go up as one rectangle
+	view_t rect{ 0, 0, 0, 0 };
+
+	for (size_t t = 0; t < _tiles.size(); ++t) {
+		const auto& tile = _tiles[t];
+
+		if (changed[t] <= _uploaded)
+			continue;
+
+		if (rect.right == tile.left && rect.top == tile.top && rect.bottom == tile.bottom) {
+			rect.right = tile.right;
+			continue;
+		}
+
+		upload(texture, rect);
+		rect = tile;
+	}
+
+	upload(texture, rect);
+	_uploaded = _versions[_front];
+	return true;
+}
+
+void FrameBuffer::upload(sf::Texture& texture, const view_t& rect) {
+	auto width = static_cast<size_t>(rect.right - rect.left);
+	auto height = static_cast<size_t>(rect.bottom - rect.top);
+
+	if (width == 0 || height == 0)
+		return;
+
+	const auto& image = front();
+	const auto stride = static_cast<size_t>(image.getSize().x) * 4;
+	const auto* pixels = image.getPixelsPtr() + rect.top * stride + rect.left * 4;
+
+	_staging.resize(width * height * 4);
+
+	for (size_t row = 0; row < height; ++row)
+		std::copy(pixels + row * stride, pixels + row * stride + width * 4, _staging.begin() + row * width * 4);
+
+	texture.update(
+		_staging.data(),
+		static_cast<unsigned>(width),
+		static_cast<unsigned>(height),
+		static_cast<unsigned>(rect.left),
+		static_cast<unsigned>(rect.top)
+	);
+}
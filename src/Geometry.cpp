@@ -1,18 +1,21 @@
 #include "Geometry.h"
 
-Scale::Scale(int_t minPixel, int_t maxPixel, flt_t minCoord, flt_t maxCoord) :
+template <typename T>
+BasicScale<T>::BasicScale(int_t minPixel, int_t maxPixel, const T& minCoord, const T& maxCoord) :
 	_min_pixel(minPixel),
 	_max_pixel(maxPixel),
 	_min_coord(minCoord),
 	_max_coord(maxCoord)
 {
-	_coord_to_pixel = Scale::GetCoordToPixelFactor(_min_pixel, _max_pixel, _min_coord, _max_coord);
+	_coord_to_pixel = BasicScale<T>::GetCoordToPixelFactor(_min_pixel, _max_pixel, _min_coord, _max_coord);
 }
 
-Scale::~Scale() {}
+template <typename T>
+BasicScale<T>::~BasicScale() {}
 
-flt_t Scale::GetCoordToPixelFactor(int_t minPixel, int_t maxPixel, flt_t minCoord, flt_t maxCoord) {
-	return (maxPixel - minPixel) / (maxCoord - minCoord);
+template <typename T>
+flt_t BasicScale<T>::GetCoordToPixelFactor(int_t minPixel, int_t maxPixel, const T& minCoord, const T& maxCoord) {
+	return (maxPixel - minPixel) / TO_FLT(maxCoord - minCoord);
 }
 
 /*
@@ -46,8 +49,9 @@ flt_t Scale::GetCoordToPixelFactor(int_t minPixel, int_t maxPixel, flt_t minCoor
 		coord_to_pixel = (max_pixel - min_pixel)/(max_coord - min_coord)
 		pixel = (coord - min_coord)(coord_to_pixel) + min_pixel
 */
-int_t Scale::to_pixel(flt_t coord) const {
-	return TO_INT((coord - _min_coord) * _coord_to_pixel) + _min_pixel;
+template <typename T>
+int_t BasicScale<T>::to_pixel(const T& coord) const {
+	return TO_INT(TO_FLT(coord - _min_coord) * _coord_to_pixel) + _min_pixel;
 }
 
 /*
@@ -65,93 +69,130 @@ int_t Scale::to_pixel(flt_t coord) const {
 	
 		coord = (pixel - min_pixel)(1/coord_to_pixel) + min_coord
 */
-flt_t Scale::to_coord(int_t pixel) const {
-	return ((pixel - _min_pixel) / _coord_to_pixel) + _min_coord;
+template <typename T>
+T BasicScale<T>::to_coord(int_t pixel) const {
+	return T((pixel - _min_pixel) / _coord_to_pixel) + _min_coord;
 }
 
-int_t Scale::min_pixel() const { return _min_pixel; }
-int_t Scale::max_pixel() const { return _max_pixel; }
-flt_t Scale::min_coord() const { return _min_coord; }
-flt_t Scale::max_coord() const { return _max_coord; }
+template <typename T>
+flt_t BasicScale<T>::pixel_size() const {
+	return 1 / _coord_to_pixel;
+}
+
+template <typename T>
+flt_t BasicScale<T>::coord_to_pixel() const {
+	return _coord_to_pixel;
+}
 
+template <typename T> int_t BasicScale<T>::min_pixel() const { return _min_pixel; }
+template <typename T> int_t BasicScale<T>::max_pixel() const { return _max_pixel; }
+template <typename T> T BasicScale<T>::min_coord() const { return _min_coord; }
+template <typename T> T BasicScale<T>::max_coord() const { return _max_coord; }
 
-YScale::YScale(int_t minPixel, int_t maxPixel, flt_t minCoord, flt_t maxCoord) :
-	Scale(minPixel, maxPixel, minCoord, maxCoord) {}
 
-YScale::~YScale() {}
+template <typename T>
+BasicYScale<T>::BasicYScale(int_t minPixel, int_t maxPixel, const T& minCoord, const T& maxCoord) :
+	BasicScale<T>(minPixel, maxPixel, minCoord, maxCoord) {}
 
-int_t YScale::to_pixel(flt_t coord) const {
-	return max_pixel() - Scale::to_pixel(coord);
+template <typename T>
+BasicYScale<T>::~BasicYScale() {}
+
+template <typename T>
+int_t BasicYScale<T>::to_pixel(const T& coord) const {
+	return this->max_pixel() - BasicScale<T>::to_pixel(coord);
 }
 
-flt_t YScale::to_coord(int_t pixel) const {
-	return Scale::to_coord(max_pixel() - pixel);
+template <typename T>
+T BasicYScale<T>::to_coord(int_t pixel) const {
+	return BasicScale<T>::to_coord(this->max_pixel() - pixel);
 }
 
-flt_t YScale::to_coord_uninverted(int_t pixel) const {
-	return Scale::to_coord(pixel);
+template <typename T>
+T BasicYScale<T>::to_coord_uninverted(int_t pixel) const {
+	return BasicScale<T>::to_coord(pixel);
 }
 
 
-Geometry2D::Geometry2D(const view_t& view, const model_t& model) :
+template <typename T>
+BasicGeometry2D<T>::BasicGeometry2D(const view_t& view, const Boundaries<T>& model) :
 	_horz(view.left, view.right, model.left, model.right),
 	_vert(view.top, view.bottom, model.top, model.bottom) {}
 
-Geometry2D::Geometry2D() :
+template <typename T>
+BasicGeometry2D<T>::BasicGeometry2D() :
 	_horz(1, 1, 1, 1),
 	_vert(1, 1, 1, 1) {}
 
-Geometry2D::~Geometry2D() {}
+template <typename T>
+BasicGeometry2D<T>::~BasicGeometry2D() {}
 
-Scale Geometry2D::horz() const { return _horz; }
-Scale Geometry2D::vert() const { return _vert; }
+template <typename T> BasicScale<T> BasicGeometry2D<T>::horz() const { return _horz; }
+template <typename T> BasicScale<T> BasicGeometry2D<T>::vert() const { return _vert; }
 
-void Geometry2D::horz(const Scale& other) {
+template <typename T>
+void BasicGeometry2D<T>::horz(const BasicScale<T>& other) {
 	_horz = other;
 }
 
-void Geometry2D::vert(const Scale& other) {
+template <typename T>
+void BasicGeometry2D<T>::vert(const BasicScale<T>& other) {
 	_vert = other;
 }
 
-void Geometry2D::horz(int_t minPixel, int_t maxPixel, flt_t minCoord, flt_t maxCoord) {
-	_horz = Scale(minPixel, maxPixel, minCoord, maxCoord);
+template <typename T>
+void BasicGeometry2D<T>::horz(int_t minPixel, int_t maxPixel, const T& minCoord, const T& maxCoord) {
+	_horz = BasicScale<T>(minPixel, maxPixel, minCoord, maxCoord);
 }
 
-void Geometry2D::vert(int_t minPixel, int_t maxPixel, flt_t minCoord, flt_t maxCoord) {
-	_vert = YScale(minPixel, maxPixel, minCoord, maxCoord);
+template <typename T>
+void BasicGeometry2D<T>::vert(int_t minPixel, int_t maxPixel, const T& minCoord, const T& maxCoord) {
+	_vert = BasicYScale<T>(minPixel, maxPixel, minCoord, maxCoord);
 }
 
-flt_t Geometry2D::coord_x(int_t pixel_x) const {
+template <typename T>
+T BasicGeometry2D<T>::coord_x(int_t pixel_x) const {
 	return _horz.to_coord(pixel_x);
 }
 
-flt_t Geometry2D::coord_y(int_t pixel_x) const {
+template <typename T>
+T BasicGeometry2D<T>::coord_y(int_t pixel_x) const {
 	return _vert.to_coord(pixel_x);
 }
 
-flt_t Geometry2D::coord_y_uninverted(int_t pixel_x) const {
+template <typename T>
+T BasicGeometry2D<T>::coord_y_uninverted(int_t pixel_x) const {
 	return _vert.to_coord(pixel_x);
 }
 
-void Geometry2D::resize(int_t min_x, int_t max_x, int_t min_y, int_t max_y) {
+template <typename T>
+void BasicGeometry2D<T>::resize(int_t min_x, int_t max_x, int_t min_y, int_t max_y) {
 	horz(min_x, max_x, _horz.min_coord(), _horz.max_coord());
 	vert(min_y, max_y, _vert.min_coord(), _vert.max_coord());
 }
 
-void Geometry2D::transform(flt_t min_x, flt_t max_x, flt_t min_y, flt_t max_y) {
+template <typename T>
+void BasicGeometry2D<T>::transform(const T& min_x, const T& max_x, const T& min_y, const T& max_y) {
 	horz(_horz.min_pixel(), _horz.max_pixel(), min_x, max_x);
-	vert(_vert.min_pixel(), _horz.max_pixel(), min_y, max_y);
+	vert(_vert.min_pixel(), _vert.max_pixel(), min_y, max_y);
 }
 
-void Geometry2D::resize(const view_t& view) {
+template <typename T>
+void BasicGeometry2D<T>::resize(const view_t& view) {
 	resize(view.left, view.right, view.top, view.bottom);
 }
 
-void Geometry2D::transform(const model_t& model) {
+template <typename T>
+void BasicGeometry2D<T>::transform(const Boundaries<T>& model) {
 	transform(model.left, model.right, model.top, model.bottom);
 }
 
+template class BasicScale<flt_t>;
+template class BasicScale<BigFloat>;
+template class BasicYScale<flt_t>;
+template class BasicYScale<BigFloat>;
+template class BasicGeometry2D<flt_t>;
+template class BasicGeometry2D<BigFloat>;
+
 
 const Geometry2D& Plot2D::geography() const {
 	return *_geography;
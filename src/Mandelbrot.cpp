@@ -1,6 +1,12 @@
 #include "Mandelbrot.h"
+#include <algorithm>
+#include <array>
+#include <limits>
 
 mnd::complex_f mnd::FunctionByOrder(int_t order) {
+	if (order >= MIN_POWER_KERNEL && order <= MAX_POWER_KERNEL)
+		return POWER_KERNELS[order - MIN_POWER_KERNEL];
+
 	return FUNCTIONS[
 		order > mnd::POWER_F_INDEX
 			? mnd::POWER_F_INDEX
@@ -8,6 +14,49 @@ mnd::complex_f mnd::FunctionByOrder(int_t order) {
 	];
 }
 
+/*
+	The cheapest type whose rounding error, PRECISION_MARGIN ulps at the
+	largest coordinate an orbit reaches, stays below the pixel spacing
+*/
+mnd::Precision mnd::SelectPrecision(const Geometry2D& scales) {
+	auto horz = scales.horz();
+	auto vert = scales.vert();
+	auto spacing = PixelSpacing(scales);
+
+	flt_t magnitude = std::max({
+		TO_FLT(ESCAPE_THRESHOLD),
+		fabsl(horz.min_coord()), fabsl(horz.max_coord()),
+		fabsl(vert.min_coord()), fabsl(vert.max_coord())
+	});
+
+	auto adequate = [=](flt_t epsilon) {
+		return epsilon * magnitude * PRECISION_MARGIN < spacing;
+	};
+
+	if (adequate(std::numeric_limits<float>::epsilon()))
+		return Precision::FLOAT;
+
+	if (adequate(std::numeric_limits<double>::epsilon()))
+		return Precision::DOUBLE;
+
+	// Skipped where long double is no wider than double, as with MSVC
+	if (std::numeric_limits<long double>::digits > std::numeric_limits<double>::digits
+		&& adequate(std::numeric_limits<long double>::epsilon()))
+		return Precision::LONG_DOUBLE;
+
+	return Precision::DOUBLE_DOUBLE;
+}
+
+flt_t mnd::PixelSpacing(const Geometry2D& scales) {
+	auto horz = scales.horz();
+	auto vert = scales.vert();
+
+	return std::min(
+		fabsl(horz.max_coord() - horz.min_coord()) / (horz.max_pixel() - horz.min_pixel()),
+		fabsl(vert.max_coord() - vert.min_coord()) / (vert.max_pixel() - vert.min_pixel())
+	);
+}
+
 std::string mnd::PowerUnitFunctionName(int_t power) {
 	return "z^" + std::to_string(power) + " + c";
 }
@@ -57,6 +106,24 @@ sf::Color mnd::HsvToColor(int_t hue, flt_t sat, flt_t val) {
 	}
 }
 
+sf::Color mnd::HueColor(int_t hue) {
+	static const auto colors = []() {
+		std::array<sf::Color, MAX_HUE> colors;
+
+		for (int_t h = 0; h < MAX_HUE; ++h)
+			colors[h] = HsvToColor(h, 1.f, 1.f);
+
+		return colors;
+	}();
+
+	hue %= MAX_HUE;
+
+	if (hue < 0)
+		hue += MAX_HUE;
+
+	return colors[hue];
+}
+
 // Source:
 //    https://www.geeksforgeeks.org/program-change-rgb-color-model-hsv-color-model/
 //    
@@ -100,30 +167,25 @@ void mnd::ColorToHsv(const sf::Color& color, int_t& hue, flt_t& sat, flt_t& val)
 	val = cmax * 100;
 }
 
-int_t mnd::EscapeTime(pair_t& z, const pair_t& c, int_t power, int_t iteration, threshold_t threshold, complex_f f) {
-	z = f(z, c, power);
-
-	if (sq_sum(z) > threshold * threshold)
-		return ESCAPE_BIAS * iteration;
-
-	return -1LL;
+int_t mnd::EscapeTimeValue(flt_t /*norm*/, int_t iteration) {
+	return ESCAPE_BIAS * iteration;
 }
 
-int_t mnd::Potential(pair_t& z, const pair_t& c, int_t power, int_t iteration, threshold_t threshold, complex_f f) {
-	z = f(z, c, power);
-	auto temp = sq_sum(z);
-
-	if (temp > threshold * threshold)
-		return POTENTIAL_BIAS * pow(2.L, iteration % 52) / LOG(temp);
+int_t mnd::PotentialValue(flt_t norm, int_t iteration) {
+	return POTENTIAL_BIAS * pow(2.L, iteration % 52) / LOG(norm);
+}
 
-	return -1LL;
+int_t mnd::DichromaticValue(flt_t /*norm*/, int_t iteration) {
+	return POTENTIAL_BIAS * (iteration % 2);
 }
 
-int_t mnd::Dichromatic(pair_t& z, const pair_t& c, int_t power, int_t iteration, threshold_t threshold, complex_f f) {
-	z = f(z, c, power);
+int_t mnd::SmoothValue(flt_t norm, int_t iteration) {
+	auto log_norm = LOG(norm);
 
-	if (sq_sum(z) > threshold * threshold)
-		return POTENTIAL_BIAS * (iteration % 2);
+	if (log_norm <= 0)
+		return EscapeTimeValue(norm, iteration);
 
-	return -1LL;
+	// log|z| is half the log of |z|^2
+	auto count = iteration + 1 - log2(log_norm / 2);
+	return std::max<int_t>(0LL, TO_INT(ESCAPE_BIAS * count));
 }
@@ -0,0 +1,122 @@
+#include "Orbits.h"
+#include <algorithm>
+
+OrbitBuffer::OrbitBuffer() :
+	_remaining(0) {}
+
+void OrbitBuffer::layout(const TileScheduler& tiles) {
+	_offsets.assign(1, 0);
+
+	for (size_t t = 0; t < tiles.size(); ++t) {
+		const auto& tile = tiles.tile(t);
+		_offsets.push_back(_offsets.back() + (tile.right - tile.left) * (tile.bottom - tile.top));
+	}
+
+	z_re.assign(size(), 0.L);
+	z_im.assign(size(), 0.L);
+	saved_re.assign(size(), 0.L);
+	saved_im.assign(size(), 0.L);
+	iterations.assign(size(), -1LL);
+	x.resize(size());
+	y.resize(size());
+	_active.assign(tiles.size(), std::vector<slot_t>());
+	_finished.assign(tiles.size(), 0);
+	_remaining = 0;
+
+	for (size_t t = 0; t < tiles.size(); ++t) {
+		const auto& tile = tiles.tile(t);
+		auto slot = begin(t);
+
+		for (int_t j = tile.top; j < tile.bottom; ++j) {
+			for (int_t i = tile.left; i < tile.right; ++i, ++slot) {
+				x[slot] = static_cast<int32_t>(i);
+				y[slot] = static_cast<int32_t>(j);
+			}
+		}
+
+		_active[t].reserve(end(t) - begin(t));
+	}
+}
+
+void OrbitBuffer::clear() {
+	_offsets.clear();
+	_active.clear();
+	_finished.clear();
+	_remaining = 0;
+	z_re = aligned_vector<flt_t>();
+	z_im = aligned_vector<flt_t>();
+	saved_re = aligned_vector<flt_t>();
+	saved_im = aligned_vector<flt_t>();
+	iterations = aligned_vector<int_t>();
+	x = aligned_vector<int32_t>();
+	y = aligned_vector<int32_t>();
+}
+
+void OrbitBuffer::reset(size_t tile) {
+	auto& active = _active[tile];
+
+	_remaining += (end(tile) - begin(tile)) - (active.size() - _finished[tile]);
+	_finished[tile] = 0;
+	active.clear();
+
+	for (auto slot = begin(tile); slot < end(tile); ++slot) {
+		z_re[slot] = 0.L;
+		z_im[slot] = 0.L;
+		saved_re[slot] = 0.L;
+		saved_im[slot] = 0.L;
+		iterations[slot] = -1LL;
+		active.push_back(static_cast<slot_t>(slot));
+	}
+}
+
+void OrbitBuffer::finish(size_t tile, size_t count) {
+	if (count == 0)
+		return;
+
+	_remaining -= count;
+	_finished[tile] += count;
+
+	if (_finished[tile] * COMPACT_RATIO >= _active[tile].size())
+		compact(tile);
+}
+
+void OrbitBuffer::compact(size_t tile) {
+	auto& active = _active[tile];
+
+	active.erase(
+		std::remove_if(active.begin(), active.end(), [this](slot_t slot) {
+			return iterations[slot] >= 0LL;
+		}),
+		active.end()
+	);
+
+	_finished[tile] = 0;
+}
+
+size_t OrbitBuffer::remaining() const {
+	return _remaining;
+}
+
+size_t OrbitBuffer::size() const {
+	return _offsets.empty() ? 0 : _offsets.back();
+}
+
+size_t OrbitBuffer::tiles() const {
+	return _active.size();
+}
+
+size_t OrbitBuffer::begin(size_t tile) const {
+	return _offsets[tile];
+}
+
+size_t OrbitBuffer::end(size_t tile) const {
+	return _offsets[tile + 1];
+}
+
+std::vector<slot_t>& OrbitBuffer::active(size_t tile) {
+	return _active[tile];
+}
+
+const std::vector<slot_t>& OrbitBuffer::active(size_t tile) const {
+	return _active[tile];
+}
@@ -22,6 +22,7 @@ Overlay::Overlay(font_t& font, geo_ptr& scales, canvas_t& window) :
 	add_text_item(TO_INT(LabelIndex::POWER));
 	add_text_item(TO_INT(LabelIndex::MAGNIFICATION));
 	add_text_item(TO_INT(LabelIndex::ITERATION));
+	add_text_item(TO_INT(LabelIndex::REMAINING));
 	add_text_item(TO_INT(LabelIndex::THRESHOLD));
 	add_text_item(TO_INT(LabelIndex::ALGORITHM));
 	add_text_item(TO_INT(LabelIndex::COLOR_SCHEME));
@@ -33,6 +34,7 @@ Overlay::Overlay(font_t& font, geo_ptr& scales, canvas_t& window) :
 	power(DEFAULT_POWER);
 	magnification(DEFAULT_MAGNIFICATION);
 	iteration(_iteration, _max_iterations);
+	remaining(0);
 	threshold(DEFAULT_THRESHOLD);
 	algorithm(DEFAULT_ALGORITHM_INDEX);
 	color_scheme(DEFAULT_COLOR_SCHEME_INDEX);
@@ -53,6 +55,7 @@ const Overlay::LabelIndex Overlay::STATIC_ITEMS[] = {
 	, LabelIndex::POWER
 	, LabelIndex::MAGNIFICATION
 	, LabelIndex::ITERATION
+	, LabelIndex::REMAINING
 	, LabelIndex::THRESHOLD
 	, LabelIndex::ALGORITHM
 	, LabelIndex::COLOR_SCHEME
@@ -145,6 +148,7 @@ Overlay& Overlay::magnification(int_t value) {
 }
 
 Overlay& Overlay::iteration(int_t it) {
+	_iteration = it;
 	_labels[(int)LabelIndex::ITERATION].setString("Iteration:  " + std::to_string(it) + " of " + std::to_string(_max_iterations));
 	return *this;
 }
@@ -154,6 +158,11 @@ Overlay& Overlay::iteration(int_t it, int_t max) {
 	return iteration(it);
 }
 
+Overlay& Overlay::remaining(int_t count) {
+	_labels[(int)LabelIndex::REMAINING].setString("Remaining:  " + std::to_string(count) + " pixels");
+	return *this;
+}
+
 Overlay& Overlay::threshold(int_t value) {
 	std::ostringstream buf;
 	buf << std::setprecision(4)
@@ -192,6 +201,7 @@ Overlay& Overlay::state(const State& other) {
 	power(other.power);
 	magnification(other.magnification);
 	iteration(0, other.max_iterations);
+	remaining(other.view.right * other.view.bottom);
 	threshold(other.threshold);
 	algorithm(other.algorithm_index);
 	color_scheme(other.color_scheme_index);
@@ -253,9 +263,9 @@ OrderedPair<int_t> TrackingBox::get_position() const {
 	};
 }
 
-model_t TrackingBox::get_boundaries(const Geometry2D& geo) const {
+deep_model_t TrackingBox::get_boundaries(const DeepGeometry2D& geo) const {
 	auto rect = _shape.getGlobalBounds();
-	return model_t{
+	return deep_model_t{
 		geo.coord_x(TO_INT(rect.left)),
 		geo.coord_x(TO_INT(rect.left) + TO_INT(rect.width)),
 		geo.coord_y(TO_INT(rect.top)),
@@ -0,0 +1,10 @@
+#include "Palette.h"
+
+Palette::Palette(mnd::color_code_f color, mnd::escape_f escape, int_t size) :
+	_color(color),
+	_escape(escape),
+	_colors(static_cast<size_t>(size))
+{
+	for (int_t value = 0; value < size; ++value)
+		_colors[static_cast<size_t>(value)] = color(value);
+}
@@ -0,0 +1,100 @@
+#include "Perturbation.h"
+#include <cmath>
+
+size_t ReferenceOrbit::size() const {
+	return _orbit.size();
+}
+
+const delta_t& ReferenceOrbit::operator[](size_t n) const {
+	return _orbit[n];
+}
+
+SeriesApproximation::SeriesApproximation() :
+	_skip(0) {}
+
+void SeriesApproximation::compute(const ReferenceOrbit& reference, bool julia, const std::vector<delta_t>& probes, threshold_t threshold) {
+	const double bailout = static_cast<double>(threshold * threshold);
+	delta_t a = julia ? delta_t(1.0, 0.0) : delta_t();
+	delta_t b, c;
+	std::vector<delta_t> d(probes.size());
+
+	_skip = 0;
+	_a = a;
+	_b = b;
+	_c = c;
+
+	if (julia)
+		d = probes;
+
+	for (size_t n = 0; n + 2 < reference.size(); ++n) {
+		const auto& z = reference[n];
+		auto z_2 = z * 2.0;
+
+		c = z_2 * c + a * b * 2.0;
+		b = z_2 * b + sq(a);
+		a = julia ? z_2 * a : z_2 * a + 1.0;
+
+		if (!std::isfinite(sq_sum(a)) || !std::isfinite(sq_sum(b)) || !std::isfinite(sq_sum(c)))
+			return;
+
+		for (size_t i = 0; i < probes.size(); ++i) {
+			const auto& e = probes[i];
+			d[i] = (z_2 + d[i]) * d[i] + (julia ? delta_t() : e);
+
+			auto exact = sq_sum(d[i]);
+			auto error = sq_sum(((c * e + b) * e + a) * e - d[i]);
+
+			auto norm = sq_sum(reference[n + 1] + d[i]);
+
+			// Past here the probe escapes or rebases, which skipping would miss
+			if (norm > bailout || norm < exact)
+				return;
+
+			if (!(error <= SERIES_TOLERANCE * SERIES_TOLERANCE * exact))
+				return;
+		}
+
+		_skip = n + 1;
+		_a = a;
+		_b = b;
+		_c = c;
+	}
+}
+
+int_t SeriesApproximation::skip() const {
+	return _skip;
+}
+
+delta_t SeriesApproximation::at(const delta_t& offset) const {
+	return ((_c * offset + _b) * offset + _a) * offset;
+}
+
+escape_t PerturbedOrbit(
+	const ReferenceOrbit& reference,
+	delta_t d,
+	const delta_t& dc,
+	int_t start,
+	int_t max_iterations,
+	threshold_t threshold
+) {
+	const double bailout = static_cast<double>(threshold * threshold);
+	size_t m = start;
+
+	for (int_t iteration = start; iteration < max_iterations; ++iteration) {
+		d = (reference[m] * 2.0 + d) * d + dc;
+		++m;
+
+		auto z = reference[m] + d;
+		auto norm = sq_sum(z);
+
+		if (norm > bailout)
+			return escape_t{ iteration, norm };
+
+		if (norm < sq_sum(d) || m + 1 >= reference.size()) {
+			d = z - reference[0];
+			m = 0;
+		}
+	}
+
+	return BOUNDED;
+}
@@ -0,0 +1,130 @@
+#include "Preview.h"
+#include "Mandelbrot.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	// Nearest pixel of scale to coord, clamped to its view
+	int_t NearestPixel(const Scale& scale, flt_t coord) {
+		auto pixel = std::llround((coord - scale.min_coord()) * scale.coord_to_pixel()) + scale.min_pixel();
+		return std::min(std::max<int_t>(pixel, scale.min_pixel()), scale.max_pixel() - 1);
+	}
+
+	// Whether two pixels have the same coordinate in every type orbits are
+	// iterated in, each of which rounds the coordinate its own way
+	bool SameCoord(const Scale& a, int_t a_pixel, const Scale& b, int_t b_pixel) {
+		return a.to_coord(a_pixel) == b.to_coord(b_pixel)
+			&& a.to_coord_as<float>(a_pixel) == b.to_coord_as<float>(b_pixel)
+			&& a.to_coord_as<double>(a_pixel) == b.to_coord_as<double>(b_pixel)
+			&& a.to_coord_as<dd_t>(a_pixel) == b.to_coord_as<dd_t>(b_pixel);
+	}
+};
+
+Preview::Preview(const sf::Image& image, const std::vector<escape_t>& values, const Geometry2D& from, const Geometry2D& to, bool reusable) :
+	_width(to.horz().max_pixel()),
+	_stopped_at(0)
+{
+	auto height = to.vert().max_pixel();
+	auto old_width = static_cast<int_t>(image.getSize().x);
+
+	_image.create(static_cast<unsigned>(_width), static_cast<unsigned>(height), mnd::INIT_COLOR);
+	_values.assign(static_cast<size_t>(_width * height), BOUNDED);
+	_known.assign(_values.size(), false);
+
+	auto old_horz = from.horz();
+	auto old_vert = from.vert();
+	auto new_horz = to.horz();
+	auto new_vert = to.vert();
+
+	// Columns map alike on every row
+	std::vector<int_t> old_xs(static_cast<size_t>(_width));
+	std::vector<bool> exact_xs(static_cast<size_t>(_width));
+
+	for (int_t x = new_horz.min_pixel(); x < _width; ++x) {
+		old_xs[x] = NearestPixel(old_horz, to.coord_x(x));
+		exact_xs[x] = reusable && SameCoord(old_horz, old_xs[x], new_horz, x);
+	}
+
+	for (int_t y = new_vert.min_pixel(); y < height; ++y) {
+		auto old_y = NearestPixel(old_vert, to.coord_y(y));
+		bool exact_y = reusable && SameCoord(old_vert, old_y, new_vert, y);
+
+		for (int_t x = new_horz.min_pixel(); x < _width; ++x) {
+			auto old_x = old_xs[x];
+			const auto& value = values[old_y * old_width + old_x];
+
+			_image.setPixel(
+				static_cast<unsigned>(x),
+				static_cast<unsigned>(y),
+				image.getPixel(static_cast<unsigned>(old_x), static_cast<unsigned>(old_y))
+			);
+
+			if (exact_y && exact_xs[x] && value.iteration >= 0LL) {
+				_values[y * _width + x] = value;
+				_known[y * _width + x] = true;
+			}
+		}
+	}
+}
+
+Preview::Preview(int_t width, int_t height) :
+	_values(static_cast<size_t>(width * height), BOUNDED),
+	_known(_values.size(), false),
+	_width(width),
+	_stopped_at(0)
+{
+	_image.create(static_cast<unsigned>(width), static_cast<unsigned>(height), mnd::INIT_COLOR);
+}
+
+void Preview::know(const std::vector<escape_t>& values, const std::vector<bool>& known, const Palette& palette) {
+	for (size_t i = 0; i < _values.size(); ++i) {
+		if (!known[i])
+			continue;
+
+		_values[i] = values[i];
+		_known[i] = true;
+		_image.setPixel(
+			static_cast<unsigned>(i % _width),
+			static_cast<unsigned>(i / _width),
+			palette.color(values[i])
+		);
+	}
+}
+
+const sf::Image& Preview::image() const {
+	return _image;
+}
+
+const std::vector<escape_t>& Preview::values() const {
+	return _values;
+}
+
+bool Preview::known(int_t x, int_t y) const {
+	return _known[y * _width + x];
+}
+
+const escape_t& Preview::value(int_t x, int_t y) const {
+	return _values[y * _width + x];
+}
+
+void Preview::resume(const std::vector<stopped_t>& orbits, int_t iteration) {
+	_stopped = orbits;
+	_stopped_index.assign(_values.size(), 0);
+	_stopped_at = iteration;
+
+	for (size_t i = 0; i < _stopped.size(); ++i)
+		_stopped_index[_stopped[i].y * _width + _stopped[i].x] = static_cast<uint32_t>(i + 1);
+}
+
+const pair_t* Preview::stopped(int_t x, int_t y) const {
+	if (_stopped_index.empty())
+		return nullptr;
+
+	auto index = _stopped_index[y * _width + x];
+	return index == 0 ? nullptr : &_stopped[index - 1].z;
+}
+
+int_t Preview::stopped_at() const {
+	return _stopped_at;
+}
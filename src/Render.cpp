@@ -1,134 +1,956 @@
 #include "Render.h"
+#include "Overlay.h"
+#include <algorithm>
+#include <type_traits>
 
-volatile std::atomic<bool> Renderer::Threads::rendering = false;
-volatile std::atomic<bool> Renderer::Threads::paused = false;
+size_t Renderer::Threads::workers = 0;
+
+size_t Renderer::Threads::count() {
+	if (workers > 0)
+		return workers;
+
+	auto hardware = std::thread::hardware_concurrency();
+	return hardware > 0 ? hardware : 1;
+}
 
 Renderer::Renderer(
-	std::reference_wrapper<sf::Image> image,
+	std::reference_wrapper<FrameBuffer> frames,
 	std::reference_wrapper<Overlay> display,
 	const State& s
 ) :
+	Renderer(frames, s)
+{
+	_on_iteration = [display](int_t iteration) {
+		display.get().iteration(iteration);
+	};
+
+	_on_remaining = [display](int_t count) {
+		display.get().remaining(count);
+	};
+}
+
+Renderer::Renderer(
+	std::reference_wrapper<FrameBuffer> frames,
+	const State& s
+) :
+	_mode(RenderMode::PROGRESSIVE),
+	_precision(mnd::Precision::AUTO),
 	_type(s.type),
-	_scales(Geometry2D(s.view, s.models.top())),
+	_deep_scales(s.geometry()),
+	_scales(_deep_scales),
 	_view(s.view),
-	_image(image),
-	_display(display),
 	_iteration(0),
-	_threshold(mnd::THRESHOLDS[s.threshold]),
 	_max_iterations(s.max_iterations),
+	_step(1LL),
+	_skip(0LL),
 	_power(s.power),
+	_threshold(mnd::THRESHOLDS[s.threshold]),
+	_subdivide(false),
 	_j_coords(s.j_coords),
-	_plot(new pair_t[s.view.bottom * s.view.right]),
+	_frames(frames),
+	_on_iteration([](int_t) {}),
+	_on_remaining([](int_t) {}),
 	_fnc(mnd::FunctionByOrder(s.power)),
-	_col(mnd::COLOR_SCHEMES[s.color_scheme_index]),
-	_alg(mnd::ALGORITHMS[s.algorithm_index])
-{}
+	_palette(s.palette()),
+	_control(std::make_shared<Control>()),
+	_pool(Renderer::Threads::count()),
+	_tiles(s.view, _pool.size()),
+	_stopped(_pool.size())
+{
+	auto tolerance = mnd::PixelSpacing(_scales) * mnd::PERIOD_TOLERANCE;
+	_period_tolerance = tolerance * tolerance;
 
-sf::Image Renderer::Start() {
-	Renderer::Threads::rendering = true;
+	// The cardioid and bulb are interior only to z^2 + c, and only while
+	// the threshold keeps their orbits (|z| <= 2) from escaping
+	_bulbs = _type == mnd::MANDELBROT
+		&& _power == 2LL
+		&& _threshold >= mnd::ESCAPE_THRESHOLD;
+}
+
+RenderMode Renderer::mode() const {
+	return _mode;
+}
+
+Renderer& Renderer::mode(RenderMode value) {
+	_mode = value;
+	return *this;
+}
+
+mnd::Precision Renderer::precision() const {
+	return _precision;
+}
+
+Renderer& Renderer::precision(mnd::Precision value) {
+	_precision = value;
+	return *this;
+}
+
+const control_ptr& Renderer::control() const {
+	return _control;
+}
+
+Renderer& Renderer::control(const control_ptr& value) {
+	_control = value;
+	return *this;
+}
+
+const preview_ptr& Renderer::preview() const {
+	return _preview;
+}
+
+Renderer& Renderer::preview(const preview_ptr& value) {
+	_preview = value;
+	return *this;
+}
+
+bool Renderer::subdivide() const {
+	return _subdivide;
+}
+
+Renderer& Renderer::subdivide(bool value) {
+	_subdivide = value;
+	return *this;
+}
+
+void Renderer::Start() {
+	// The first frame, blank or the preview, replaces whatever the UI showed
+	// before
+	_frames.get().layout(_tiles);
+	_frames.get().publish();
+
+	if (_mode != RenderMode::PROGRESSIVE) {
+		for (auto& stopped : _stopped)
+			stopped.clear();
+
+		_iteration = 0;
+		_on_iteration(_iteration);
+		return;
+	}
+
+	if (_orbits.size() == 0)
+		_orbits.layout(_tiles);
 
 	switch (_type) {
 	case mnd::MANDELBROT:
-		Interruptible::InitializePlot(_plot, _view);
+		Interruptible::InitializePlot(*_control, _orbits, _scales, _bulbs);
 		_color_pixel_method = &Renderer::ColorMandelbrotPixel;
 		break;
 	case mnd::JULIA:
-		Interruptible::InitializeJulia(_plot, _view, _scales);
+		Interruptible::InitializeJulia(*_control, _orbits, _scales);
 		_color_pixel_method = &Renderer::ColorJuliaPixel;
 		break;
 	}
 
-	_display.get().init_iteration();
+	if (_preview)
+		SeedFromPreview(_frames.get().back());
 
-	sf::Image someImage;
-	someImage.create(_view.right, _view.bottom, mnd::INIT_COLOR);
-	return someImage;
+	_iteration = 0;
+	_on_iteration(_iteration);
+	_on_remaining(_orbits.remaining());
 }
 
 bool Renderer::HasNext() {
-	return Renderer::Threads::rendering&& _display.get().iteration() < _max_iterations;
+	return _control->running() && _iteration < _max_iterations;
 }
 
 void Renderer::Close() {
-	Renderer::Threads::rendering = false;
-
-	if (_plot != nullptr) {
-		delete[] _plot;
-		_plot = nullptr;
+	if (_preview && _orbits.size() > 0 && _control->running() && _iteration >= _max_iterations) {
+		if (ClearActive(_frames.get().back()) > 0)
+			_frames.get().publish();
 	}
+
+	_control->cancel();
+	_orbits.clear();
 }
 
-void Renderer::Next(sf::Image& someImage) {
-	while (Renderer::Threads::paused);
+void Renderer::Next() {
+	if (!_control->wait())
+		return;
 
-	if (RenderFrame(someImage) > 0)
-		_image.get() = someImage;
+	if (RenderFrame(_frames.get().back()) > 0)
+		_frames.get().publish();
 
-	_iteration = _display.get().next_iteration();
+	_on_remaining(_orbits.remaining());
+	_on_iteration(++_iteration);
 }
 
 void Renderer::Run() {
-	auto someImage = Start();
+	Start();
+
+	switch (_mode) {
+	case RenderMode::PIXEL_MAJOR:
+		if (RenderOrbits(_frames.get().back()) > 0) {
+			_frames.get().touch_all();
+			_frames.get().publish();
+		}
+
+		if (_control->running()) {
+			KeepStopped();
+			_iteration = _max_iterations;
+			_on_iteration(_iteration);
+			_on_remaining(0LL);
+		}
+
+		break;
+	case RenderMode::COARSE_TO_FINE:
+		for (auto step : PASS_STEPS) {
+			_step = step;
+			RenderOrbits(_frames.get().back());
+
+			// A pass cut short would mix blocks of two resolutions
+			if (!_control->running())
+				break;
+
+			_frames.get().touch_all();
+			_frames.get().publish();
+			_skip = step;
 
-	while (HasNext())
-		Next(someImage);
+			// Pixels off this pass's grid are left for the finer ones
+			auto width = _view.right - _view.left;
+			auto height = _view.bottom - _view.top;
+			_on_remaining(width * height - ((width + step - 1) / step) * ((height + step - 1) / step));
+		}
+
+		_step = 1LL;
+		_skip = 0LL;
+
+		if (_control->running()) {
+			KeepStopped();
+			_iteration = _max_iterations;
+			_on_iteration(_iteration);
+		}
+
+		break;
+	case RenderMode::PROGRESSIVE:
+		while (HasNext())
+			Next();
+
+		break;
+	}
 
 	Close();
 }
 
-bool Renderer::ColorPixel(sf::Image& someImage, int_t x, int_t y, pair_t c) {
-	if (someImage.getPixel(x, y) == mnd::INIT_COLOR) {
-		auto index = (_view.right - _view.left) * y + x;
-		auto value = _alg(_plot[index], c, _power, _iteration, _threshold, _fnc);
+bool Renderer::ColorPixel(sf::Image& someImage, slot_t slot, pair_t c) {
+	pair_t z = _fnc(pair_t{ _orbits.z_re[slot], _orbits.z_im[slot] }, c, _power);
+	auto norm = sq_sum(z);
+
+	_orbits.z_re[slot] = z.re();
+	_orbits.z_im[slot] = z.im();
+
+	if (norm > _threshold * _threshold) {
+		escape_t value{ _iteration, static_cast<double>(norm) };
+		_orbits.iterations[slot] = _iteration;
+		someImage.setPixel(_orbits.x[slot], _orbits.y[slot], _palette.color(value));
+		_frames.get().value(_orbits.x[slot], _orbits.y[slot], value);
+		return true;
+	}
+
+	// Every pixel is on the same iteration, so one Brent schedule serves all
+	pair_t saved{ _orbits.saved_re[slot], _orbits.saved_im[slot] };
+
+	if (sq_sum(z - saved) < _period_tolerance) {
+		_orbits.iterations[slot] = _iteration;
 
-		if (value >= 0LL) {
-			someImage.setPixel(x, y, _col(value));
+		if (_preview) {
+			someImage.setPixel(_orbits.x[slot], _orbits.y[slot], mnd::INIT_COLOR);
 			return true;
 		}
 	}
+	else if (mnd::IsPeriodSave(_iteration)) {
+		_orbits.saved_re[slot] = z.re();
+		_orbits.saved_im[slot] = z.im();
+	}
 
 	return false;
 }
 
-bool Renderer::ColorMandelbrotPixel(sf::Image& someImage, int_t x, int_t y) {
-	return ColorPixel(someImage, x, y, pair_t{ _scales.coord_x(x), _scales.coord_y(y) });
+bool Renderer::ColorMandelbrotPixel(sf::Image& someImage, slot_t slot) {
+	return ColorPixel(someImage, slot, pair_t{ _scales.coord_x(_orbits.x[slot]), _scales.coord_y(_orbits.y[slot]) });
 }
 
-bool Renderer::ColorJuliaPixel(sf::Image& someImage, int_t x, int_t y) {
-	return ColorPixel(someImage, x, y, _j_coords);
+bool Renderer::ColorJuliaPixel(sf::Image& someImage, slot_t slot) {
+	return ColorPixel(someImage, slot, _j_coords);
 }
 
+// Runs the orbit of one pixel to escape or the maximum, keeping z local
+// instead of storing it in the plot between iterations
+escape_t Renderer::OrbitValue(int_t x, int_t y) {
+	pair_t coords{ _scales.coord_x(x), _scales.coord_y(y) };
+	pair_t z = _type == mnd::JULIA ? coords : INIT_PAIR;
+	pair_t c = _type == mnd::JULIA ? _j_coords : coords;
+
+	pair_t saved = z;
+
+	for (int_t iteration = 0; iteration < _max_iterations; ++iteration) {
+		z = _fnc(z, c, _power);
+		auto norm = sq_sum(z);
+
+		if (norm > _threshold * _threshold)
+			return escape_t{ iteration, static_cast<double>(norm) };
+
+		if (iteration % CANCEL_INTERVAL == 0 && !_control->running())
+			return BOUNDED;
+
+		if (sq_sum(z - saved) < _period_tolerance)
+			return BOUNDED;
+
+		if (mnd::IsPeriodSave(iteration))
+			saved = z;
+	}
+
+	return BOUNDED;
+}
+
+// Known pixels finish before the first iteration; the cardioid and bulb,
+// finished already, are painted over the preview
+void Renderer::SeedFromPreview(sf::Image& someImage) {
+	for (size_t t = 0; _control->running() && t < _orbits.tiles(); ++t) {
+		size_t known = 0;
+		size_t interior = 0;
+
+		for (auto slot = _orbits.begin(t); slot < _orbits.end(t); ++slot) {
+			if (_orbits.iterations[slot] >= 0LL) {
+				someImage.setPixel(_orbits.x[slot], _orbits.y[slot], mnd::INIT_COLOR);
+				++interior;
+			}
+			else if (_preview->known(_orbits.x[slot], _orbits.y[slot])) {
+				_orbits.iterations[slot] = 0LL;
+				++known;
+			}
+		}
+
+		_orbits.finish(t, known);
+
+		if (interior > 0)
+			_frames.get().touch(t);
+	}
+}
+
+// Hands the FrameBuffer the orbits a finished render stopped, gathered from
+// every worker and pass
+void Renderer::KeepStopped() {
+	std::vector<stopped_t> orbits;
+
+	for (const auto& stopped : _stopped)
+		orbits.insert(orbits.end(), stopped.begin(), stopped.end());
+
+	_frames.get().stopped(std::move(orbits), _max_iterations);
+}
+
+// Paints the orbits still active at the maximum iteration over the preview
+int Renderer::ClearActive(sf::Image& someImage) {
+	int cleared = 0;
+
+	for (size_t t = 0; t < _orbits.tiles(); ++t) {
+		int count = 0;
+
+		for (auto slot : _orbits.active(t)) {
+			if (_orbits.iterations[slot] < 0LL) {
+				someImage.setPixel(_orbits.x[slot], _orbits.y[slot], mnd::INIT_COLOR);
+				++count;
+			}
+		}
+
+		if (count > 0)
+			_frames.get().touch(t);
+
+		cleared += count;
+	}
+
+	return cleared;
+}
+
+// Visits only the active slots of each tile; the worker that owns a tile
+// this frame also compacts its list, so compaction runs in parallel
 int Renderer::RenderFrame(sf::Image& someImage) {
-	std::vector<std::thread> threads;
 	volatile std::atomic<int> rendered = 0;
 
-	auto render_task = [&](view_t view) {
-		int_t x, y;
+	_tiles.reset();
+
+	_pool.Run([&](size_t worker) {
+		size_t tile;
+
+		while (_control->running() && _tiles.next(worker, tile)) {
+			int count = 0;
+			size_t finished = 0;
+
+			for (auto slot : _orbits.active(tile)) {
+				if (!_control->running())
+					break;
+
+				if (_orbits.iterations[slot] >= 0LL)
+					continue;
+
+				if ((this->*_color_pixel_method)(someImage, slot))
+					++count;
+
+				if (_orbits.iterations[slot] >= 0LL)
+					++finished;
+			}
+
+			_orbits.finish(tile, finished);
+
+			if (count > 0)
+				_frames.get().touch(tile);
+
+			rendered += count;
+		}
+	});
+
+	return rendered;
+}
+
+// The first pixel from pixel on that is a sample of the current pass
+int_t Renderer::FirstSample(int_t pixel) const {
+	return pixel + (_step - pixel % _step) % _step;
+}
+
+// Whether the pass before already sampled the pixel
+bool Renderer::Taken(int_t x, int_t y) const {
+	return _skip > 0LL && x % _skip == 0LL && y % _skip == 0LL;
+}
+
+// Colors the pixel by its escape, INIT_COLOR where it has none, and in a
+// coarse pass the block up to the next samples
+void Renderer::Plot(sf::Image& someImage, int_t x, int_t y, const escape_t& value) {
+	auto color = _palette.color(value);
+	auto right = std::min(x + _step, _view.right);
+	auto bottom = std::min(y + _step, _view.bottom);
+
+	for (int_t j = y; j < bottom; ++j) {
+		for (int_t i = x; i < right; ++i) {
+			someImage.setPixel(i, j, color);
+			_frames.get().value(i, j, value);
+		}
+	}
+}
+
+// Plots the escape the preview knows for the pixel, if it knows one
+bool Renderer::PlotKnown(sf::Image& someImage, int_t x, int_t y) {
+	if (_mode != RenderMode::COARSE_TO_FINE || !_preview || !_preview->known(x, y))
+		return false;
+
+	Plot(someImage, x, y, _preview->value(x, y));
+	return true;
+}
+
+// Plots the pixel if its orbit escaped; coarse-to-fine passes also paint
+// over the blocks of the pass before where it did not
+bool Renderer::PlotValue(sf::Image& someImage, int_t x, int_t y, const escape_t& value) {
+	if (value.iteration >= 0LL || _mode == RenderMode::COARSE_TO_FINE)
+		Plot(someImage, x, y, value);
+
+	return value.iteration >= 0LL;
+}
+
+// Hands each worker whole tiles; draw(worker, tile) returns the number of
+// pixels it colored
+template <typename F>
+int Renderer::RenderTiles(F draw) {
+	volatile std::atomic<int> rendered = 0;
+
+	_tiles.reset();
+
+	_pool.Run([&](size_t worker) {
+		view_t tile;
+
+		while (_control->running() && _tiles.next(worker, tile)) {
+			if (!_control->wait())
+				break;
+
+			rendered += draw(worker, tile);
+		}
+	});
+
+	return rendered;
+}
+
+// Computes the samples of the current pass a row at a time
+int Renderer::RenderRows(sf::Image& someImage, const values_f& values) {
+	return RenderTiles([&](size_t worker, const view_t& tile) {
+		std::vector<int_t> xs, ys;
+		std::vector<escape_t> results;
+		int rendered = 0;
+
+		for (int_t y = FirstSample(tile.top); _control->running() && y < tile.bottom; y += _step) {
+			xs.clear();
+
+			for (int_t x = FirstSample(tile.left); x < tile.right; x += _step) {
+				if (Taken(x, y))
+					continue;
+
+				if (PlotKnown(someImage, x, y))
+					++rendered;
+				else
+					xs.push_back(x);
+			}
+
+			ys.assign(xs.size(), y);
+			results.resize(xs.size());
+			values(worker, xs.data(), ys.data(), xs.size(), results.data());
 
-		for (y = view.top; Renderer::Threads::rendering && y < view.bottom; ++y)
-			for (x = view.left; Renderer::Threads::rendering && x < view.right; ++x)
-				if ((this->*_color_pixel_method)(someImage, x, y))
+			for (size_t i = 0; i < xs.size(); ++i)
+				if (PlotValue(someImage, xs[i], y, results[i]))
 					++rendered;
+		}
+
+		return rendered;
+	});
+}
+
+/*
+	Source:
+		Wikipedia, "Plotting algorithms for the Mandelbrot set",
+		Mariani-Silver algorithm
+
+	The Mandelbrot set and filled Julia sets are connected and have no
+	holes, so a rectangle whose border lies in the set lies in it whole;
+	bands of one escape iteration are taken to behave alike, their |z|
+	blended across each row for smooth coloring. Any other rectangle is
+	split across its longer side down to MIN_SUBDIVISION pixels, below which
+	its inside is computed outright
+
+	Rectangles include their borders: [left, right] x [top, bottom]. The
+	view starts as SUBDIVISION_BLOCK blocks whose borders are traced by the
+	worker that takes them. A split computes the line between the halves
+	before queueing them, so every rectangle queued has its border known
+	and no two workers share a pixel. Rectangles within a tile stay with
+	their worker; larger ones can be stolen. Every pixel is computed at
+	most once, and not at all where the preview knows it or a coarser pass
+	sampled it
+*/
+int Renderer::RenderSubdivided(sf::Image& someImage, const values_f& values) {
+	struct Batch {
+		std::vector<int_t> xs, ys;
+		std::vector<escape_t> results;
 	};
 
-	threads.push_back(std::thread(render_task, view_t{ _view.left, _view.right / 2, _view.top, _view.bottom / 2 }));
-	threads.push_back(std::thread(render_task, view_t{ _view.right / 2, _view.right, _view.top, _view.bottom / 2 }));
-	threads.push_back(std::thread(render_task, view_t{ _view.left, _view.right / 2, _view.bottom / 2, _view.bottom }));
-	threads.push_back(std::thread(render_task, view_t{ _view.right / 2, _view.right, _view.bottom / 2, _view.bottom }));
+	int_t width = _view.right - _view.left;
+	std::vector<uint8_t> seen(width * (_view.bottom - _view.top), 0);
+	std::vector<Batch> batches(_pool.size());
+	RectangleQueue rects(_pool.size());
+	volatile std::atomic<int> rendered = 0;
+	size_t block = 0;
+
+	for (int_t y = _view.top; y < _view.bottom; y += SUBDIVISION_BLOCK)
+		for (int_t x = _view.left; x < _view.right; x += SUBDIVISION_BLOCK)
+			rects.push(block++, view_t{
+				x,
+				std::min(x + SUBDIVISION_BLOCK, _view.right) - 1,
+				y,
+				std::min(y + SUBDIVISION_BLOCK, _view.bottom) - 1
+			});
+
+	_pool.Run([&](size_t worker) {
+		auto& batch = batches[worker];
+		std::vector<view_t> local;
+		int count = 0;
+		view_t rect;
+
+		// The frame holds the escape of every pixel plotted, taken or computed
+		auto at = [&](int_t x, int_t y) -> const escape_t& {
+			return _frames.get().value(x, y);
+		};
+
+		// Pixels the preview knows are plotted instead of queued
+		auto known = [&](int_t x, int_t y) {
+			if (!PlotKnown(someImage, x, y))
+				return false;
+
+			++count;
+			return true;
+		};
+
+		// Samples of the passes before are already plotted, so they are
+		// neither computed nor filled; the rest are queued once
+		auto queue = [&](int_t x, int_t y) {
+			auto& flag = seen[(y - _view.top) * width + (x - _view.left)];
+
+			if (flag)
+				return;
+
+			flag = 1;
+
+			if (!Taken(x, y) && !known(x, y)) {
+				batch.xs.push_back(x);
+				batch.ys.push_back(y);
+			}
+		};
+
+		auto compute = [&]() {
+			batch.results.resize(batch.xs.size());
+			values(worker, batch.xs.data(), batch.ys.data(), batch.xs.size(), batch.results.data());
+
+			for (size_t i = 0; i < batch.xs.size(); ++i) {
+				_frames.get().value(batch.xs[i], batch.ys[i], batch.results[i]);
+
+				if (PlotValue(someImage, batch.xs[i], batch.ys[i], batch.results[i]))
+					++count;
+			}
+
+			batch.xs.clear();
+			batch.ys.clear();
+		};
+
+		// Rectangles within a tile are too small to be worth stealing
+		auto hand = [&](const view_t& child) {
+			if (child.right - child.left > DEFAULT_TILE_SIZE || child.bottom - child.top > DEFAULT_TILE_SIZE)
+				rects.push(worker, child);
+			else
+				local.push_back(child);
+		};
+
+		auto split = [&](const view_t& rect) {
+			// Only a block's border is not known yet
+			for (int_t x = rect.left; x <= rect.right; ++x) {
+				queue(x, rect.top);
+				queue(x, rect.bottom);
+			}
+
+			for (int_t y = rect.top + 1; y < rect.bottom; ++y) {
+				queue(rect.left, y);
+				queue(rect.right, y);
+			}
+
+			compute();
+
+			int_t w = rect.right - rect.left;
+			int_t h = rect.bottom - rect.top;
+
+			if (w < 2 || h < 2)
+				return;
+
+			auto iteration = at(rect.left, rect.top).iteration;
+			bool uniform = true;
+
+			for (int_t x = rect.left; uniform && x <= rect.right; ++x)
+				uniform = at(x, rect.top).iteration == iteration && at(x, rect.bottom).iteration == iteration;
+
+			for (int_t y = rect.top + 1; uniform && y < rect.bottom; ++y)
+				uniform = at(rect.left, y).iteration == iteration && at(rect.right, y).iteration == iteration;
+
+			if (uniform) {
+				for (int_t y = rect.top + 1; y < rect.bottom; ++y) {
+					auto left = at(rect.left, y).norm;
+					auto right = at(rect.right, y).norm;
+
+					for (int_t x = rect.left + 1; x < rect.right; ++x) {
+						if (Taken(x, y) || known(x, y))
+							continue;
+
+						auto t = static_cast<double>(x - rect.left) / w;
+						escape_t value{ iteration, left + (right - left) * t };
+						_frames.get().value(x, y, value);
+
+						if (PlotValue(someImage, x, y, value))
+							++count;
+					}
+				}
+			}
+			else if (w <= MIN_SUBDIVISION && h <= MIN_SUBDIVISION) {
+				for (int_t y = rect.top + 1; y < rect.bottom; ++y)
+					for (int_t x = rect.left + 1; x < rect.right; ++x)
+						queue(x, y);
+
+				compute();
+			}
+			else if (w >= h) {
+				auto middle = rect.left + w / 2;
+
+				for (int_t y = rect.top + 1; y < rect.bottom; ++y)
+					queue(middle, y);
+
+				compute();
+				hand(view_t{ rect.left, middle, rect.top, rect.bottom });
+				hand(view_t{ middle, rect.right, rect.top, rect.bottom });
+			}
+			else {
+				auto middle = rect.top + h / 2;
+
+				for (int_t x = rect.left + 1; x < rect.right; ++x)
+					queue(x, middle);
+
+				compute();
+				hand(view_t{ rect.left, rect.right, rect.top, middle });
+				hand(view_t{ rect.left, rect.right, middle, rect.bottom });
+			}
+		};
+
+		while (rects.pop(worker, rect)) {
+			if (_control->wait()) {
+				split(rect);
+
+				while (!local.empty() && _control->running()) {
+					rect = local.back();
+					local.pop_back();
+					split(rect);
+				}
+			}
+			else {
+				rects.close();
+			}
+
+			rects.finish();
+		}
+
+		rendered += count;
+	});
 
-	Join(threads);
 	return rendered;
 }
 
-void Renderer::Interruptible::InitializePlot(plot_t& plot, const view_t& view) {
-	for (int_t i = 0; Renderer::Threads::rendering && i < view.bottom * view.right; ++i)
-		plot[i] = INIT_PAIR;
+// Keeps where an orbit stopped at the maximum for the next, higher one,
+// and plots it as bounded; a pair_t cannot hold a double-double z
+template <typename T>
+escape_t Renderer::Stop(size_t worker, int_t x, int_t y, const escape_t& escape, const Complex<T>& z) {
+	if (escape.iteration != STOPPED.iteration)
+		return escape;
+
+	if constexpr (!std::is_same<T, dd_t>::value)
+		_stopped[worker].push_back(stopped_t{ x, y, pair_t{ static_cast<flt_t>(z.re()), static_cast<flt_t>(z.im()) } });
+
+	return BOUNDED;
+}
+
+template <typename T>
+values_f Renderer::PowerValues() {
+	auto orbit = mnd::PowerOrbitByOrder<T>(_power);
+	Complex<T> j_coords{ T(_j_coords.re()), T(_j_coords.im()) };
+	T tolerance(_period_tolerance);
+
+	return [=](size_t worker, const int_t* xs, const int_t* ys, size_t count, escape_t* values) {
+		for (size_t i = 0; i < count; ++i) {
+			Complex<T> coords{ _scales.coord_x_as<T>(xs[i]), _scales.coord_y_as<T>(ys[i]) };
+
+			if (!_control->running() || (_bulbs && mnd::InCardioidOrBulb(coords.re(), coords.im()))) {
+				values[i] = BOUNDED;
+				continue;
+			}
+
+			auto z = _type == mnd::JULIA ? coords : Complex<T>();
+			auto c = _type == mnd::JULIA ? j_coords : coords;
+			int_t start = 0LL;
+			auto stopped = _preview ? _preview->stopped(xs[i], ys[i]) : nullptr;
+
+			if (stopped != nullptr) {
+				z = Complex<T>{ T(stopped->re()), T(stopped->im()) };
+				start = _preview->stopped_at();
+			}
+
+			values[i] = Stop(worker, xs[i], ys[i], orbit(z, c, start, _max_iterations, _threshold, tolerance), z);
+		}
+	};
 }
 
-void Renderer::Interruptible::InitializeJulia(plot_t& plot, const view_t& view, const Geometry2D& scales) {
-	int_t x, y;
-	
-	for (y = view.top; Renderer::Threads::rendering && y < view.bottom; ++y)
-		for (x = view.left; Renderer::Threads::rendering && x < view.right; ++x)
-			plot[(view.right - view.left) * y + x] = { scales.coord_x(x), scales.coord_y(y) };
+template <typename T>
+values_f Renderer::VectorValues(simd::kernel_f<T> kernel) {
+	simd::OrbitParams<T> params{
+		_max_iterations,
+		T(_threshold * _threshold),
+		_type == mnd::JULIA,
+		T(_j_coords.re()),
+		T(_j_coords.im()),
+		T(_period_tolerance),
+		_bulbs
+	};
+
+	// The kernel's inputs and outputs, one set per worker for the pass; each
+	// only grows, so after the first calls nothing is allocated
+	struct Scratch {
+		std::vector<T> re, im, norms, z_re, z_im;
+		std::vector<int_t> iterations;
+		std::vector<size_t> pixels;
+	};
+
+	auto scratch = std::make_shared<std::vector<Scratch>>(_pool.size());
+
+	// Orbits every lane would start at iteration 0, so those going on from
+	// a stop run scalar
+	auto resumed = PowerValues<T>();
+
+	return [=](size_t worker, const int_t* xs, const int_t* ys, size_t count, escape_t* values) {
+		auto& s = (*scratch)[worker];
+
+		if (s.re.size() < count) {
+			for (auto vector : { &s.re, &s.im, &s.norms, &s.z_re, &s.z_im })
+				vector->resize(count);
+
+			s.iterations.resize(count);
+			s.pixels.resize(count);
+		}
+
+		size_t lanes = 0;
+
+		for (size_t i = 0; i < count; ++i) {
+			if (_preview && _preview->stopped(xs[i], ys[i]) != nullptr) {
+				resumed(worker, xs + i, ys + i, 1, values + i);
+				continue;
+			}
+
+			s.pixels[lanes] = i;
+			s.re[lanes] = _scales.coord_x_as<T>(xs[i]);
+			s.im[lanes] = _scales.coord_y_as<T>(ys[i]);
+			++lanes;
+		}
+
+		kernel(params, s.re.data(), s.im.data(), lanes, s.iterations.data(), s.norms.data(), s.z_re.data(), s.z_im.data());
+
+		for (size_t l = 0; l < lanes; ++l) {
+			auto i = s.pixels[l];
+
+			if (s.iterations[l] >= 0LL)
+				values[i] = escape_t{ s.iterations[l], static_cast<double>(s.norms[l]) };
+			else if (s.iterations[l] == simd::STOPPED)
+				values[i] = Stop(worker, xs[i], ys[i], STOPPED, Complex<T>{ s.z_re[l], s.z_im[l] });
+			else
+				values[i] = BOUNDED;
+		}
+	};
+}
+
+// Vector kernels where the CPU has them, scalar orbits otherwise
+template <typename T>
+values_f Renderer::TypedValues() {
+	if constexpr (std::is_same<T, float>::value || std::is_same<T, double>::value) {
+		auto kernel = simd::KernelByOrder<T>(_power);
+
+		if (kernel != nullptr)
+			return VectorValues<T>(kernel);
+	}
+
+	return PowerValues<T>();
+}
+
+// The reference is the center pixel, so every offset stays within half
+// the view; offsets are exact in double however deep the view. Pixels
+// start where the series approximation leaves off
+values_f Renderer::PerturbedValues() {
+	int_t center_x = (_view.left + _view.right) / 2;
+	int_t center_y = (_view.top + _view.bottom) / 2;
+	double pixel_x = static_cast<double>(_scales.horz().pixel_size());
+	double pixel_y = static_cast<double>(_scales.vert().pixel_size());
+
+	// Computed once, for the first of the passes over the view
+	if (_reference.size() == 0) {
+		Complex<BigFloat> center{ _deep_scales.coord_x(center_x), _deep_scales.coord_y(center_y) };
+
+		if (_type == mnd::JULIA)
+			_reference.compute(*_control, center, Complex<BigFloat>(_j_coords.re(), _j_coords.im()), _max_iterations, _threshold);
+		else
+			_reference.compute(*_control, Complex<BigFloat>(), center, _max_iterations, _threshold);
+
+		if (!_control->running())
+			return nullptr;
+
+		std::vector<delta_t> corners;
+
+		for (auto x : { _view.left, _view.right - 1 })
+			for (auto y : { _view.top, _view.bottom - 1 })
+				corners.push_back(delta_t{ (x - center_x) * pixel_x, (y - center_y) * pixel_y });
+
+		_series.compute(_reference, _type == mnd::JULIA, corners, _threshold);
+	}
+
+	return [=](size_t, const int_t* xs, const int_t* ys, size_t count, escape_t* values) {
+		for (size_t i = 0; i < count; ++i) {
+			if (!_control->running() || (_bulbs && mnd::InCardioidOrBulb(_scales.coord_x(xs[i]), _scales.coord_y(ys[i])))) {
+				values[i] = BOUNDED;
+				continue;
+			}
+
+			delta_t offset{ (xs[i] - center_x) * pixel_x, (ys[i] - center_y) * pixel_y };
+
+			values[i] = PerturbedOrbit(
+				_reference,
+				_series.at(offset),
+				_type == mnd::JULIA ? delta_t() : offset,
+				_series.skip(),
+				_max_iterations,
+				_threshold
+			);
+		}
+	};
+}
+
+values_f Renderer::OrbitValues() {
+	if (mnd::PowerOrbitByOrder<flt_t>(_power) != nullptr) {
+		auto precision = _precision == mnd::Precision::AUTO
+			? mnd::SelectPrecision(_scales)
+			: _precision;
+
+		if (_power == 2LL) {
+			if (precision == mnd::Precision::PERTURBATION
+				|| (precision == mnd::Precision::DOUBLE_DOUBLE && _precision == mnd::Precision::AUTO))
+				return PerturbedValues();
+		}
+		else if (precision == mnd::Precision::PERTURBATION) {
+			precision = mnd::Precision::DOUBLE_DOUBLE;
+		}
+
+		switch (precision) {
+		case mnd::Precision::FLOAT:
+			return TypedValues<float>();
+		case mnd::Precision::DOUBLE:
+			return TypedValues<double>();
+		case mnd::Precision::DOUBLE_DOUBLE:
+			return TypedValues<dd_t>();
+		default:
+			return TypedValues<flt_t>();
+		}
+	}
+
+	return [this](size_t, const int_t* xs, const int_t* ys, size_t count, escape_t* values) {
+		for (size_t i = 0; i < count; ++i)
+			values[i] = _control->running() ? OrbitValue(xs[i], ys[i]) : BOUNDED;
+	};
+}
+
+int Renderer::RenderOrbits(sf::Image& someImage) {
+	auto values = OrbitValues();
+
+	if (!values)
+		return 0;
+
+	// Subdivision fills whole pixels, so only the full-resolution pass, and
+	// only z^d + c escaping at 2 keeps its level sets free of holes
+	if (_subdivide && _step == 1LL
+		&& mnd::PowerOrbitByOrder<flt_t>(_power) != nullptr
+		&& _threshold >= mnd::ESCAPE_THRESHOLD)
+		return RenderSubdivided(someImage, values);
+
+	return RenderRows(someImage, values);
+}
+
+void Renderer::Interruptible::InitializePlot(const Control& control, OrbitBuffer& orbits, const Geometry2D& scales, bool bulbs) {
+	for (size_t t = 0; control.running() && t < orbits.tiles(); ++t) {
+		orbits.reset(t);
+
+		if (!bulbs)
+			continue;
+
+		size_t interior = 0;
+
+		for (auto slot = orbits.begin(t); slot < orbits.end(t); ++slot) {
+			if (mnd::InCardioidOrBulb(scales.coord_x(orbits.x[slot]), scales.coord_y(orbits.y[slot]))) {
+				orbits.iterations[slot] = 0LL;
+				++interior;
+			}
+		}
+
+		orbits.finish(t, interior);
+	}
+}
+
+void Renderer::Interruptible::InitializeJulia(const Control& control, OrbitBuffer& orbits, const Geometry2D& scales) {
+	for (size_t t = 0; control.running() && t < orbits.tiles(); ++t) {
+		orbits.reset(t);
+
+		for (auto slot = orbits.begin(t); slot < orbits.end(t); ++slot) {
+			orbits.z_re[slot] = scales.coord_x(orbits.x[slot]);
+			orbits.z_im[slot] = scales.coord_y(orbits.y[slot]);
+			orbits.saved_re[slot] = orbits.z_re[slot];
+			orbits.saved_im[slot] = orbits.z_im[slot];
+		}
+	}
 }
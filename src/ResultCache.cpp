@@ -0,0 +1,111 @@
+#include "ResultCache.h"
+#include <functional>
+
+namespace
+{
+	// Source:
+	//    boost::hash_combine
+	void Combine(size_t& seed, size_t value) {
+		seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+	}
+
+	template <typename T>
+	void Combine(size_t& seed, const T& value) {
+		Combine(seed, std::hash<T>()(value));
+	}
+
+	bool SameView(const view_t& a, const view_t& b) {
+		return a.left == b.left && a.right == b.right && a.top == b.top && a.bottom == b.bottom;
+	}
+
+	bool SameModel(const deep_model_t& a, const deep_model_t& b) {
+		return a.left == b.left && a.right == b.right && a.top == b.top && a.bottom == b.bottom;
+	}
+};
+
+RenderKey::RenderKey(const State& state) :
+	view(state.view),
+	model(state.models.top()),
+	type(state.type),
+	j_coords(state.type == mnd::JULIA ? state.j_coords : INIT_PAIR),
+	power(state.power),
+	threshold(state.threshold),
+	max_iterations(state.max_iterations),
+	hash(0)
+{
+	// Models equal to the last bit hash alike in long double; the few that
+	// differ only deeper are told apart by operator==
+	for (auto bound : { model.left, model.right, model.top, model.bottom })
+		Combine(hash, static_cast<flt_t>(bound));
+
+	for (auto value : { view.right, view.bottom, type, power, threshold, max_iterations })
+		Combine(hash, value);
+
+	Combine(hash, j_coords.re());
+	Combine(hash, j_coords.im());
+}
+
+bool RenderKey::operator==(const RenderKey& other) const {
+	return hash == other.hash
+		&& SameView(view, other.view)
+		&& type == other.type
+		&& j_coords.re() == other.j_coords.re()
+		&& j_coords.im() == other.j_coords.im()
+		&& power == other.power
+		&& threshold == other.threshold
+		&& max_iterations == other.max_iterations
+		&& SameModel(model, other.model);
+}
+
+ResultCache::ResultCache(size_t budget) :
+	_budget(budget),
+	_bytes(0) {}
+
+size_t ResultCache::budget() const {
+	return _budget;
+}
+
+ResultCache& ResultCache::budget(size_t bytes) {
+	_budget = bytes;
+	trim();
+	return *this;
+}
+
+size_t ResultCache::bytes() const {
+	return _bytes;
+}
+
+const std::vector<escape_t>* ResultCache::find(const State& state) {
+	RenderKey key(state);
+
+	for (auto entry = _entries.begin(); entry != _entries.end(); ++entry) {
+		if (entry->key == key) {
+			_entries.splice(_entries.begin(), _entries, entry);
+			return &_entries.front().values;
+		}
+	}
+
+	return nullptr;
+}
+
+bool ResultCache::add(const State& state, const std::vector<escape_t>& values) {
+	if (find(state) != nullptr)
+		return false;
+
+	_entries.push_front(Entry{ RenderKey(state), values });
+	_bytes += values.size() * sizeof(escape_t);
+	trim();
+	return true;
+}
+
+void ResultCache::clear() {
+	_entries.clear();
+	_bytes = 0;
+}
+
+void ResultCache::trim() {
+	while (_bytes > _budget && !_entries.empty()) {
+		_bytes -= _entries.back().values.size() * sizeof(escape_t);
+		_entries.pop_back();
+	}
+}
@@ -22,7 +22,8 @@ flt_t to_float(const std::string& word) {
 	int i = 0, j, k = 0;
 	std::string couplet;
 
-	while (i < word.length()) {
+	// Whole couplets only, and no more than a flt_t holds
+	while (i + COUPLET_SIZE <= word.length() && k < FLT_T_SIZE) {
 		couplet = "";
 		j = 0;
 
@@ -84,7 +85,11 @@ flt_t get_flt(std::string str) {
 std::string GetDateTimeString() {
 	std::time_t temp = std::time(nullptr);
 	struct tm time;
+#ifdef _WIN32
 	localtime_s(&time, &temp);
+#else
+	localtime_r(&temp, &time);
+#endif
 
 	std::string mon = std::to_string(time.tm_mon + 1);
 	std::string day = std::to_string(time.tm_mday);
@@ -0,0 +1,93 @@
+#include "SimdKernel.h"
+
+#if defined(SIMD_X86) && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+simd::Isa simd::limit = simd::Isa::AVX512;
+
+// Source:
+//    Intel 64 and IA-32 Architectures Software Developer's Manual,
+//    Vol. 1, 14.3 and 15.2, "Detection of ... support"
+//
+// The CPU must report the instructions, and the OS must save the wider
+// registers (XCR0) across context switches
+simd::Isa simd::Detect() {
+#if defined(SIMD_X86) && defined(_MSC_VER)
+	int info[4];
+
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return Isa::SCALAR;
+
+	__cpuid(info, 1);
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+
+	if (!osxsave || !avx)
+		return Isa::SCALAR;
+
+	auto xcr0 = _xgetbv(0);
+
+	// XMM and YMM state
+	if ((xcr0 & 0x06) != 0x06)
+		return Isa::SCALAR;
+
+	__cpuidex(info, 7, 0);
+	bool avx2 = (info[1] & (1 << 5)) != 0;
+	bool avx512f = (info[1] & (1 << 16)) != 0;
+
+	// Opmask, upper ZMM0-15 and ZMM16-31 state
+	if (avx512f && (xcr0 & 0xe0) == 0xe0)
+		return Isa::AVX512;
+
+	return avx2 ? Isa::AVX2 : Isa::SCALAR;
+#elif defined(SIMD_X86) && defined(__GNUC__)
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("avx512f"))
+		return Isa::AVX512;
+
+	if (__builtin_cpu_supports("avx2"))
+		return Isa::AVX2;
+
+	return Isa::SCALAR;
+#else
+	return Isa::SCALAR;
+#endif
+}
+
+simd::Isa simd::Active() {
+	static const Isa detected = Detect();
+	return detected < limit ? detected : limit;
+}
+
+template <typename T>
+static simd::kernel_f<T> ActiveKernel(int_t order) {
+	if (order < simd::MIN_ORDER || order > simd::MAX_ORDER)
+		return nullptr;
+
+#ifdef SIMD_X86
+	switch (simd::Active()) {
+	case simd::Isa::AVX512:
+		return simd::avx512::KernelByOrder(order, T());
+	case simd::Isa::AVX2:
+		return simd::avx2::KernelByOrder(order, T());
+	default:
+		break;
+	}
+#endif
+
+	return nullptr;
+}
+
+template <>
+simd::kernel_f<float> simd::KernelByOrder<float>(int_t order) {
+	return ActiveKernel<float>(order);
+}
+
+template <>
+simd::kernel_f<double> simd::KernelByOrder<double>(int_t order) {
+	return ActiveKernel<double>(order);
+}
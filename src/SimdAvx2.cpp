@@ -0,0 +1,55 @@
+// Built for its instruction set regardless of the project-wide target; the
+// caller dispatches here only after simd::Detect() reports support. Fused
+// multiply-adds stay off so lanes round like the scalar orbits
+#ifdef __GNUC__
+#pragma GCC optimize("fp-contract=off")
+#pragma GCC target("avx2")
+#endif
+
+#include "SimdKernel.h"
+
+#ifdef SIMD_X86
+#include <immintrin.h>
+
+namespace simd
+{
+	namespace avx2
+	{
+		struct Float {
+			typedef float scalar_t;
+			typedef __m256 vec_t;
+			static const size_t LANES = 8;
+
+			static vec_t load(const float* p) { return _mm256_loadu_ps(p); }
+			static void store(float* p, vec_t v) { _mm256_storeu_ps(p, v); }
+			static vec_t set1(float v) { return _mm256_set1_ps(v); }
+			static vec_t add(vec_t a, vec_t b) { return _mm256_add_ps(a, b); }
+			static vec_t sub(vec_t a, vec_t b) { return _mm256_sub_ps(a, b); }
+			static vec_t mul(vec_t a, vec_t b) { return _mm256_mul_ps(a, b); }
+			static int greater(vec_t a, vec_t b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ)); }
+		};
+
+		struct Double {
+			typedef double scalar_t;
+			typedef __m256d vec_t;
+			static const size_t LANES = 4;
+
+			static vec_t load(const double* p) { return _mm256_loadu_pd(p); }
+			static void store(double* p, vec_t v) { _mm256_storeu_pd(p, v); }
+			static vec_t set1(double v) { return _mm256_set1_pd(v); }
+			static vec_t add(vec_t a, vec_t b) { return _mm256_add_pd(a, b); }
+			static vec_t sub(vec_t a, vec_t b) { return _mm256_sub_pd(a, b); }
+			static vec_t mul(vec_t a, vec_t b) { return _mm256_mul_pd(a, b); }
+			static int greater(vec_t a, vec_t b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GT_OQ)); }
+		};
+
+		kernel_f<float> KernelByOrder(int_t order, float) {
+			return KernelTable<Float>::KERNELS[order - MIN_ORDER];
+		}
+
+		kernel_f<double> KernelByOrder(int_t order, double) {
+			return KernelTable<Double>::KERNELS[order - MIN_ORDER];
+		}
+	};
+};
+#endif
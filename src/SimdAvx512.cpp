@@ -0,0 +1,53 @@
+// As SimdAvx2.cpp, for AVX-512F: 512-bit registers and opmask compares
+#ifdef __GNUC__
+#pragma GCC optimize("fp-contract=off")
+#pragma GCC target("avx512f")
+#endif
+
+#include "SimdKernel.h"
+
+#ifdef SIMD_X86
+#include <immintrin.h>
+
+namespace simd
+{
+	namespace avx512
+	{
+		struct Float {
+			typedef float scalar_t;
+			typedef __m512 vec_t;
+			static const size_t LANES = 16;
+
+			static vec_t load(const float* p) { return _mm512_loadu_ps(p); }
+			static void store(float* p, vec_t v) { _mm512_storeu_ps(p, v); }
+			static vec_t set1(float v) { return _mm512_set1_ps(v); }
+			static vec_t add(vec_t a, vec_t b) { return _mm512_add_ps(a, b); }
+			static vec_t sub(vec_t a, vec_t b) { return _mm512_sub_ps(a, b); }
+			static vec_t mul(vec_t a, vec_t b) { return _mm512_mul_ps(a, b); }
+			static int greater(vec_t a, vec_t b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+		};
+
+		struct Double {
+			typedef double scalar_t;
+			typedef __m512d vec_t;
+			static const size_t LANES = 8;
+
+			static vec_t load(const double* p) { return _mm512_loadu_pd(p); }
+			static void store(double* p, vec_t v) { _mm512_storeu_pd(p, v); }
+			static vec_t set1(double v) { return _mm512_set1_pd(v); }
+			static vec_t add(vec_t a, vec_t b) { return _mm512_add_pd(a, b); }
+			static vec_t sub(vec_t a, vec_t b) { return _mm512_sub_pd(a, b); }
+			static vec_t mul(vec_t a, vec_t b) { return _mm512_mul_pd(a, b); }
+			static int greater(vec_t a, vec_t b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+		};
+
+		kernel_f<float> KernelByOrder(int_t order, float) {
+			return KernelTable<Float>::KERNELS[order - MIN_ORDER];
+		}
+
+		kernel_f<double> KernelByOrder(int_t order, double) {
+			return KernelTable<Double>::KERNELS[order - MIN_ORDER];
+		}
+	};
+};
+#endif
@@ -1,4 +1,6 @@
 #include "State.h"
+#include <algorithm>
+#include <limits>
 
 view_t State::_init_view = { 0LL, 1LL, 0LL, 1LL };
 
@@ -8,17 +10,17 @@ int_t min_power() {
 
 model_stack_t init_model_stack() {
 	model_stack_t models;
-	models.push(model_t{
+	models.push(BoundariesCast<BigFloat>(model_t{
 		DEFAULT_ZOOM * INIT_MODEL.left,
 		DEFAULT_ZOOM * INIT_MODEL.right,
 		DEFAULT_ZOOM * INIT_MODEL.top,
 		DEFAULT_ZOOM * INIT_MODEL.bottom
-	});
-	models.push(INIT_MODEL);
+	}));
+	models.push(BoundariesCast<BigFloat>(INIT_MODEL));
 	return models;
 }
 
-model_stack_t push(model_stack_t models, model_t model) {
+model_stack_t push(model_stack_t models, deep_model_t model) {
 	models.push(model);
 	return models;
 }
@@ -28,6 +30,17 @@ model_stack_t pop(model_stack_t models) {
 	return models;
 }
 
+deep_model_t zoom_box(const DeepGeometry2D& geo, int_t x, int_t y, int_t width, int_t height) {
+	auto left = TO_INT(x - width / 2.f);
+	auto top = TO_INT(y - height / 2.f);
+	return deep_model_t{
+		geo.coord_x(left),
+		geo.coord_x(left + width),
+		geo.coord_y(top),
+		geo.coord_y(top + height)
+	};
+}
+
 State::State() :
 	view(State::_init_view),
 	models(::init_model_stack()),
@@ -99,6 +112,23 @@ State& State::init_model_stack() {
 }
 
 State& State::push_model(model_t value) {
+	return push_model(BoundariesCast<BigFloat>(value));
+}
+
+// Each model carries enough limbs to resolve its own pixels, so the cost
+// of its arithmetic grows with the zoom depth and no further
+State& State::push_model(deep_model_t value) {
+	auto spacing = std::min(
+		TO_FLT(abs(value.right - value.left)) / (view.right - view.left),
+		TO_FLT(abs(value.bottom - value.top)) / (view.bottom - view.top)
+	);
+
+	auto limbs = BigFloat::LimbsForSpacing(spacing);
+	value.left.limbs(limbs);
+	value.right.limbs(limbs);
+	value.top.limbs(limbs);
+	value.bottom.limbs(limbs);
+
 	return new_model_stack(push(models, value));
 }
 
@@ -227,3 +257,131 @@ State& State::prev_color_scheme() {
 
 	return *this;
 }
+
+DeepGeometry2D State::geometry() const {
+	return DeepGeometry2D(view, models.top());
+}
+
+Palette State::palette() const {
+	return Palette(
+		mnd::COLOR_SCHEMES[color_scheme_index],
+		mnd::ESCAPE_VALUES[algorithm_index],
+		PaletteSize(max_iterations)
+	);
+}
+
+pair_t State::center() const {
+	auto left = models.top().left;
+	auto top = models.top().top;
+	return pair_t{
+		TO_FLT(left + abs(left - models.top().right) * BigFloat(0.5)),
+		TO_FLT(top + abs(top - models.top().bottom) * BigFloat(0.5))
+	};
+}
+
+State& State::zoom_in(pair_t coords, int_t factor) {
+	auto geo = geometry();
+
+	return push_model(
+		zoom_box(
+			geo,
+			geo.horz().to_pixel(coords.re()),
+			geo.vert().to_pixel(coords.im()),
+			(view.right - view.left) / factor,
+			(view.bottom - view.top) / factor
+		))
+		.next_magnification();
+}
+
+State& State::zoom_out() {
+	return pop_model().prev_magnification();
+}
+
+State& State::go_to(const std::string& str, int_t factor) {
+	std::stringstream buf(str);
+	std::string temp;
+
+	buf.ignore(std::numeric_limits<std::streamsize>::max(), '-');
+
+	if (!buf || buf.eof())
+		buf = std::stringstream(str);
+	else
+		buf.ignore(1, '_');
+
+	getline(buf, temp, '_');
+	int_t someType = std::stoll(temp);
+
+	getline(buf, temp, '_');
+	int_t somePower = get_int(temp);
+
+	// Written in hex by file_name
+	getline(buf, temp, '_');
+	int_t someMagnification = std::stoll(temp, nullptr, 16);
+
+	// The iteration the capture was taken at; a render starts over
+	getline(buf, temp, '_');
+
+	getline(buf, temp, '_');
+	flt_t coord_x = get_flt(temp);
+
+	getline(buf, temp, someType == mnd::JULIA ? '_' : '.');
+	flt_t coord_y = get_flt(temp);
+
+	new_type(someType)
+		.new_power(somePower)
+		.init_model_stack()
+		.init_magnification()
+		.init_max_iterations();
+
+	if (someType == mnd::JULIA) {
+		getline(buf, temp, '_');
+		flt_t j_coord_x = get_flt(temp);
+
+		getline(buf, temp, '.');
+		flt_t j_coord_y = get_flt(temp);
+
+		new_j_coords(pair_t{ j_coord_x, j_coord_y });
+	}
+
+	while (someMagnification < magnification && models.size() > 1)
+		zoom_out();
+
+	while (someMagnification > magnification)
+		zoom_in(pair_t{ coord_x, coord_y }, factor);
+
+	return *this;
+}
+
+// Format:
+// 
+//    type_power_magnification_iteration_x_y[_jx_jy]
+//    
+std::string State::file_name(int_t iteration) const {
+	auto coords = center();
+	std::ostringstream buf;
+
+	buf << type << '_';
+	put_int(buf, power);
+
+	auto fill = buf.fill();
+
+	buf << '_'
+		<< std::hex << magnification << '_'
+		<< std::setfill('0')
+		<< std::setw(std::to_string(max_iterations).length())
+		<< std::dec << iteration << '_'
+		<< std::setfill(fill);
+
+	put_flt(buf, coords.re());
+	buf << '_';
+	put_flt(buf, coords.im());
+
+	if (type == mnd::JULIA) {
+		buf << '_';
+		put_flt(buf, j_coords.re());
+		buf << '_';
+		put_flt(buf, j_coords.im());
+	}
+
+	return buf.str();
+}
@@ -19,3 +19,104 @@ void Threads::Join() {
 		if (thread.get().joinable())
 			thread.get().join();
 }
+
+Control::Control() :
+	_running(true),
+	_paused(false) {}
+
+void Control::cancel() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_running = false;
+	}
+
+	_resumed.notify_all();
+}
+
+bool Control::running() const {
+	return _running;
+}
+
+bool Control::pause(bool value) {
+	bool previous;
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		previous = _paused.exchange(value);
+	}
+
+	if (!value)
+		_resumed.notify_all();
+
+	return previous;
+}
+
+void Control::resume() {
+	pause(false);
+}
+
+bool Control::paused() const {
+	return _paused;
+}
+
+bool Control::wait() {
+	if (!_paused)
+		return _running;
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	_resumed.wait(lock, [this]() { return !_paused || !_running; });
+	return _running;
+}
+
+ThreadPool::ThreadPool(size_t count) :
+	_generation(0),
+	_pending(0),
+	_stopping(false)
+{
+	for (size_t i = 0; i < count; ++i)
+		_workers.push_back(std::thread(&ThreadPool::Work, this, i));
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stopping = true;
+	}
+
+	_started.notify_all();
+	::Join(_workers);
+}
+
+size_t ThreadPool::size() const {
+	return _workers.size();
+}
+
+void ThreadPool::Run(const task_f& task) {
+	std::unique_lock<std::mutex> lock(_mutex);
+	_task = task;
+	_pending = _workers.size();
+	++_generation;
+	_started.notify_all();
+	_finished.wait(lock, [this]() { return _pending == 0; });
+	_task = nullptr;
+}
+
+void ThreadPool::Work(size_t index) {
+	size_t generation = 0;
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	while (true) {
+		_started.wait(lock, [&]() { return _stopping || _generation != generation; });
+
+		if (_stopping)
+			return;
+
+		generation = _generation;
+		lock.unlock();
+		_task(index);
+		lock.lock();
+
+		if (--_pending == 0)
+			_finished.notify_one();
+	}
+}
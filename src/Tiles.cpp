@@ -0,0 +1,154 @@
+#include "Tiles.h"
+
+TileScheduler::TileScheduler(const view_t& view, size_t workers, int_t tile_size) :
+	_runs(workers == 0 ? 1 : workers)
+{
+	for (int_t y = view.top; y < view.bottom; y += tile_size)
+		for (int_t x = view.left; x < view.right; x += tile_size)
+			_tiles.push_back(view_t{
+				x,
+				x + tile_size < view.right ? x + tile_size : view.right,
+				y,
+				y + tile_size < view.bottom ? y + tile_size : view.bottom
+			});
+
+	for (size_t i = 0; i < _runs.size(); ++i) {
+		_runs[i].begin = _tiles.size() * i / _runs.size();
+		_runs[i].end = _tiles.size() * (i + 1) / _runs.size();
+	}
+
+	reset();
+}
+
+size_t TileScheduler::size() const {
+	return _tiles.size();
+}
+
+size_t TileScheduler::workers() const {
+	return _runs.size();
+}
+
+void TileScheduler::reset() {
+	for (auto& run : _runs)
+		run.next = run.begin;
+}
+
+bool TileScheduler::next(size_t worker, view_t& tile) {
+	size_t index;
+
+	if (!next(worker, index))
+		return false;
+
+	tile = _tiles[index];
+	return true;
+}
+
+bool TileScheduler::next(size_t worker, size_t& index) {
+	for (size_t i = 0; i < _runs.size(); ++i) {
+		auto& run = _runs[(worker + i) % _runs.size()];
+
+		if (run.next.load(std::memory_order_relaxed) >= run.end)
+			continue;
+
+		index = run.next.fetch_add(1, std::memory_order_relaxed);
+
+		if (index < run.end)
+			return true;
+	}
+
+	return false;
+}
+
+const view_t& TileScheduler::tile(size_t index) const {
+	return _tiles[index];
+}
+
+RectangleQueue::RectangleQueue(size_t workers) :
+	_deques(workers == 0 ? 1 : workers),
+	_queued(0),
+	_pending(0),
+	_closed(false),
+	_waiting(0)
+{}
+
+// Counted before it can be taken, so _pending never drops to zero early
+void RectangleQueue::push(size_t worker, const view_t& rect) {
+	++_pending;
+	++_queued;
+
+	{
+		auto& deque = _deques[worker % _deques.size()];
+		std::lock_guard<std::mutex> lock(deque.mutex);
+		deque.rects.push_back(rect);
+	}
+
+	notify(false);
+}
+
+bool RectangleQueue::take(size_t worker, view_t& rect) {
+	for (size_t i = 0; i < _deques.size(); ++i) {
+		auto& deque = _deques[(worker + i) % _deques.size()];
+		std::lock_guard<std::mutex> lock(deque.mutex);
+
+		if (deque.rects.empty())
+			continue;
+
+		if (i == 0) {
+			rect = deque.rects.back();
+			deque.rects.pop_back();
+		}
+		else {
+			rect = deque.rects.front();
+			deque.rects.pop_front();
+		}
+
+		--_queued;
+		return true;
+	}
+
+	return false;
+}
+
+bool RectangleQueue::pop(size_t worker, view_t& rect) {
+	while (!_closed) {
+		if (take(worker, rect))
+			return true;
+
+		std::unique_lock<std::mutex> lock(_mutex);
+		++_waiting;
+		_idle.wait(lock, [this] { return _closed || _queued > 0 || _pending == 0; });
+		--_waiting;
+
+		if (_pending == 0)
+			return false;
+	}
+
+	return false;
+}
+
+void RectangleQueue::finish() {
+	if (--_pending == 0)
+		notify(true);
+}
+
+void RectangleQueue::close() {
+	_closed = true;
+	notify(true);
+}
+
+// A waiter counts itself before its last check, so with none counted
+// there is no one to wake; taking the lock orders the wake-up after that
+// check, so none is lost
+void RectangleQueue::notify(bool all) {
+	if (_waiting == 0)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+	}
+
+	if (all)
+		_idle.notify_all();
+	else
+		_idle.notify_one();
+}
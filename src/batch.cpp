@@ -0,0 +1,227 @@
+#include "Render.h"
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+const int_t WIDTH_PIXELS = 1200;
+const int_t HEIGHT_PIXELS = 900;
+const char* const DEFAULT_EXTENSION = ".png";
+
+const char* const USAGE_MSG =
+	"Usage: mandelbrot-batch [filename] [options]"
+	"\n"
+	"\n  filename : screen capture file name, or its coordinate part"
+	"\n"
+	"\n  -w <pixels>     : image width"
+	"\n  -h <pixels>     : image height"
+	"\n  -i <iterations> : max iterations"
+	"\n  -o <path>       : output file"
+	"\n  -t <threads>    : render workers (default: one per hardware thread)"
+	"\n  -p              : render progressively, one iteration at a time"
+	"\n  -s              : subdivide tiles, filling rectangles of one escape iteration"
+	"\n  -f <precision>  : auto, float, double, long, dd or perturb (default: auto)"
+	"\n  -v <isa>        : highest vector instruction set, scalar, avx2 or avx512"
+	"\n  -c <msec>       : cancel the render after msec and report how long it took to stop"
+	"\n  -z <factor>     : zoom per magnification step of filename (default: as the application)"
+	"\n"
+;
+
+struct BatchArgs {
+	std::string coords;
+	std::string output;
+	int_t width = WIDTH_PIXELS;
+	int_t height = HEIGHT_PIXELS;
+	int_t max_iterations = -1LL;
+	RenderMode mode = RenderMode::PIXEL_MAJOR;
+	mnd::Precision precision = mnd::Precision::AUTO;
+	bool subdivide = false;
+	int_t cancel_msec = -1LL;
+	int_t zoom = DEFAULT_ZOOM;
+};
+
+// Whole numbers only; malformed or out-of-range text fails the parse
+bool ParseInt(const std::string& value, int_t& result) {
+	size_t length = 0;
+
+	try {
+		result = std::stoll(value, &length);
+	}
+	catch (const std::invalid_argument&) {
+		return false;
+	}
+	catch (const std::out_of_range&) {
+		return false;
+	}
+
+	return length == value.length();
+}
+
+bool ParsePrecision(const std::string& value, mnd::Precision& precision) {
+	const char* const names[] = { "auto", "float", "double", "long", "dd", "perturb" };
+
+	for (size_t i = 0; i < ARRAY_SIZE(names); ++i) {
+		if (value == names[i]) {
+			precision = static_cast<mnd::Precision>(i);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool ParseIsa(const std::string& value, simd::Isa& isa) {
+	const char* const names[] = { "scalar", "avx2", "avx512" };
+
+	for (size_t i = 0; i < ARRAY_SIZE(names); ++i) {
+		if (value == names[i]) {
+			isa = static_cast<simd::Isa>(i);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool ParseArgs(const std::vector<std::string>& args, BatchArgs& batch) {
+	for (size_t i = 1; i < args.size(); ++i) {
+		const auto& arg = args[i];
+
+		if (arg == "-p") {
+			batch.mode = RenderMode::PROGRESSIVE;
+		}
+		else if (arg == "-s") {
+			batch.subdivide = true;
+		}
+		else if (arg.length() == 2 && arg[0] == '-') {
+			if (i + 1 >= args.size())
+				return false;
+
+			const auto& value = args[++i];
+
+			int_t number = 0LL;
+
+			switch (arg[1]) {
+			case 'w':
+				if (!ParseInt(value, batch.width))
+					return false;
+				break;
+			case 'h':
+				if (!ParseInt(value, batch.height))
+					return false;
+				break;
+			case 'i':
+				if (!ParseInt(value, batch.max_iterations))
+					return false;
+				break;
+			case 'o':
+				batch.output = value;
+				break;
+			case 't':
+				if (!ParseInt(value, number) || number <= 0LL)
+					return false;
+				Renderer::Threads::workers = static_cast<size_t>(number);
+				break;
+			case 'f':
+				if (!ParsePrecision(value, batch.precision))
+					return false;
+				break;
+			case 'v':
+				if (!ParseIsa(value, simd::limit))
+					return false;
+				break;
+			case 'c':
+				if (!ParseInt(value, batch.cancel_msec))
+					return false;
+				break;
+			case 'z':
+				if (!ParseInt(value, batch.zoom))
+					return false;
+				break;
+			default:
+				return false;
+			}
+		}
+		else {
+			batch.coords = arg;
+		}
+	}
+
+	return batch.width > 0 && batch.height > 0 && batch.zoom > 0;
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<std::string> args;
+	BatchArgs batch;
+
+	for (int i = 0; i < argc; ++i)
+		args.push_back(std::string(argv[i]));
+
+	if (!ParseArgs(args, batch)) {
+		std::cerr << USAGE_MSG;
+		return 1;
+	}
+
+	State state(batch.width, batch.height);
+
+	if (!batch.coords.empty()) {
+		try {
+			state.go_to(batch.coords, batch.zoom);
+		}
+		catch (const std::invalid_argument&) {
+			std::cerr << USAGE_MSG;
+			return 1;
+		}
+		catch (const std::out_of_range&) {
+			std::cerr << USAGE_MSG;
+			return 1;
+		}
+	}
+
+	if (batch.max_iterations > 0)
+		state.new_max_iterations(batch.max_iterations);
+
+	if (batch.output.empty())
+		batch.output = state.file_name(state.max_iterations) + DEFAULT_EXTENSION;
+
+	FrameBuffer frames;
+	frames.create(state.view.right, state.view.bottom, mnd::INIT_COLOR);
+
+	auto control = std::make_shared<Control>();
+	auto start = std::chrono::steady_clock::now();
+
+	std::thread render([&]() {
+		Renderer(std::ref(frames), state).mode(batch.mode).precision(batch.precision).subdivide(batch.subdivide).control(control).Run();
+	});
+
+	if (batch.cancel_msec >= 0LL) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(batch.cancel_msec));
+		auto cancelled = std::chrono::steady_clock::now();
+		control->cancel();
+		render.join();
+
+		std::cout
+			<< "stopped in "
+			<< std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - cancelled).count()
+			<< " us\n";
+	}
+	else {
+		render.join();
+	}
+
+	auto elapsed = std::chrono::steady_clock::now() - start;
+
+	frames.acquire();
+
+	if (!frames.front().saveToFile(batch.output)) {
+		std::cerr << "Could not save " << batch.output << '\n';
+		return 1;
+	}
+
+	std::cout
+		<< batch.output << ": "
+		<< std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()
+		<< " ms\n";
+
+	return 0;
+}
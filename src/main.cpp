@@ -100,9 +100,7 @@ int main(int argc, char** argv)
 							int_t newMaximum;
 
 							if (app.EnterNewMaximum(newMaximum))
-								app.ChangeOverlayAndHistory([&]() {
-									app.current_state.new_max_iterations(newMaximum);
-								});
+								app.ChangeMaximum(newMaximum);
 						}
 
 						break;
@@ -144,7 +142,7 @@ int main(int argc, char** argv)
 						Application::delay_next_poll = true;
 						break;
 					case sf::Keyboard::Key::V:
-						if (Renderer::Threads::paused)
+						if (app.IsPaused())
 							app.TogglePauseRender();
 
 						app.StopRenderAsync();
@@ -164,12 +162,12 @@ int main(int argc, char** argv)
 
 						break;
 					case sf::Keyboard::Key::Up:
-						app.ChangeOverlayAndHistory([&]() {
+						app.ChangeColorScheme([&]() {
 							app.current_state.prev_algorithm();
 						});
 						break;
 					case sf::Keyboard::Key::Down:
-						app.ChangeOverlayAndHistory([&]() {
+						app.ChangeColorScheme([&]() {
 							app.current_state.next_algorithm();
 						});
 						break;
@@ -198,7 +196,7 @@ int main(int argc, char** argv)
 								});
 						}
 						else {
-							app.ChangeOverlayAndHistory([&]() {
+							app.ChangeColorScheme([&]() {
 								app.current_state.prev_color_scheme();
 							});
 						}
@@ -219,7 +217,7 @@ int main(int argc, char** argv)
 								});
 						}
 						else {
-							app.ChangeOverlayAndHistory([&]() {
+							app.ChangeColorScheme([&]() {
 								app.current_state.next_color_scheme();
 							});
 						}